@@ -80,6 +80,7 @@
 
 #define BLACK 0
 #define WHITE 1
+#define INVERSE 2 // flips the pixels, so drawing the same thing again restores them
 #define TRANSPARENT 255
 #define SOLID 127
 
@@ -93,6 +94,292 @@
 #define FONT_HASSPACE       8
 #define FONT_FULL           255
 
+// text alignments
+#define ALIGN_LEFT   0
+#define ALIGN_CENTER 1
+#define ALIGN_RIGHT  2
+
+// region library_config
+// set it to 1 to count the I2C traffic generated by the library (see getBusStats())
+#ifndef SH1106_BUSSTATS
+#define SH1106_BUSSTATS 0
+#endif
+// set it to 1 to enable the queued drawing functions, that are executed step by step by service()
+#ifndef SH1106_INCREMENTAL
+#define SH1106_INCREMENTAL 0
+#endif
+// set it to 1 to enable the timed display effects, flash() and fadeTo(), that are advanced by updateEffects()
+#ifndef SH1106_EFFECTS
+#define SH1106_EFFECTS 0
+#endif
+// how many columns the drawing functions read, compose in the RAM and write back at once (it is that many bytes of stack)
+// 0 draws column by column in the ReadModifyWrite mode, which needs no buffer, but costs more bus traffic per column
+#ifndef SH1106_COMPOSE_BUFFER
+#define SH1106_COMPOSE_BUFFER 0
+#endif
+// set it to 1 to compose 4 columns at once in 32 bit words, 0 uses a byte loop
+// the byte loop is the faster one on the 8 bit AVRs, the words are on the 32 bit devices. Either one is only used with
+// SH1106_COMPOSE_BUFFER, which is 0 on every device by default, so the compose kernels are opt-in
+#ifndef SH1106_WORD_KERNELS
+#if defined(__AVR__)
+#define SH1106_WORD_KERNELS 0
+#else
+#define SH1106_WORD_KERNELS 1
+#endif
+#endif
+// how many queued drawing operations can wait for service() at once (each one costs 17 bytes of RAM on AVR)
+#ifndef SH1106_JOBQUEUE_SIZE
+#define SH1106_JOBQUEUE_SIZE 4
+#endif
+// how many columns service() draws in one step - smaller steps keep it closer to its time budget
+#ifndef SH1106_JOBSTEP_SIZE
+#define SH1106_JOBSTEP_SIZE 8
+#endif
+// how many draw commands fit into an SH1106CommandQueue - has to be a power of 2 (each one costs 11 bytes of RAM on AVR)
+#ifndef SH1106_COMMANDQUEUE_SIZE
+#define SH1106_COMMANDQUEUE_SIZE 8
+#endif
+// the maximum number of characters in an SH1106TextField (each one costs 1 byte of RAM per field)
+#ifndef SH1106_TEXTFIELD_LENGTH
+#define SH1106_TEXTFIELD_LENGTH 8
+#endif
+// how many lines an SH1106TextLayout can remember (each one costs 3 bytes of RAM per layout)
+#ifndef SH1106_TEXTLAYOUT_LINES
+#define SH1106_TEXTLAYOUT_LINES 8
+#endif
+// endregion library_config
+
+// region tilemap_constants
+#define SH1106_TILE_SIZE 8
+#define SH1106_TILEMAP_COLUMNS (SH1106_LCDWIDTH / SH1106_TILE_SIZE)
+#define SH1106_TILEMAP_ROWS (SH1106_LCDHEIGHT / SH1106_TILE_SIZE)
+// endregion tilemap_constants
+
+// region textsize_constants
+#define SH1106_MAX_TEXTSIZE 4
+// the nibbles spread to 2, 3 and 4 times their width (bit k is repeated at the bits k*n .. k*n+n-1), for setTextSize()
+static const uint16_t SH1106_SPREAD[SH1106_MAX_TEXTSIZE - 1][16] PROGMEM = {
+	{ 0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F, 0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF },
+	{ 0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF, 0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF },
+	{ 0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF, 0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF }
+};
+// endregion textsize_constants
+
+// region dither_constants
+#define SH1106_DITHER_LEVELS 64
+// the 8x8 ordered dither (Bayer) matrix, by rows: a pixel is lit, if its value is smaller than the level
+static const uint8_t SH1106_BAYER[8][8] PROGMEM = {
+	{  0, 32,  8, 40,  2, 34, 10, 42 },
+	{ 48, 16, 56, 24, 50, 18, 58, 26 },
+	{ 12, 44,  4, 36, 14, 46,  6, 38 },
+	{ 60, 28, 52, 20, 62, 30, 54, 22 },
+	{  3, 35, 11, 43,  1, 33,  9, 41 },
+	{ 51, 19, 59, 27, 49, 17, 57, 25 },
+	{ 15, 47,  7, 39, 13, 45,  5, 37 },
+	{ 63, 31, 55, 23, 61, 29, 53, 21 }
+};
+// endregion dither_constants
+
+/*
+The visible part of something that is drawn, in screen coordinates (the right column and the bottom row are included)
+*/
+struct SH1106ClipArea
+{
+	uint8_t left;
+	uint8_t top;
+	uint8_t right;
+	uint8_t bottom;
+};
+
+#if SH1106_BUSSTATS
+/*
+Counters of the I2C traffic generated by the library
+*/
+struct SH1106BusStats
+{
+	uint32_t starts;       // START and repeated START conditions (each followed by an address byte)
+	uint32_t stops;        // STOP conditions
+	uint32_t bytesWritten; // bytes sent to the display, address bytes included
+	uint32_t bytesRead;    // bytes received from the display
+};
+#endif
+
+#if SH1106_INCREMENTAL
+#define SH1106_JOB_CLEAR 0
+#define SH1106_JOB_FILLRECT 1
+#define SH1106_JOB_BITMAP 2
+#define SH1106_JOB_TRANSPOSED 3
+
+/*
+A queued drawing operation, and how far it got
+*/
+struct SH1106Job
+{
+	uint8_t type;           // SH1106_JOB_*
+	int16_t x;              // where the bitmap starts, after the origin was added
+	int16_t y;
+	uint8_t w;              // the size of the bitmap
+	uint8_t h;
+	SH1106ClipArea area;    // the visible part on the display (a transposed bitmap keeps the screen coordinates)
+	uint8_t color;
+	uint8_t backgroundType;
+	const byte *bitmap;
+	uint8_t part;           // the page of the display being drawn
+	uint8_t column;         // the next column to draw on that page (the next row of the screen for a transposed bitmap)
+};
+#endif
+
+#define SH1106_CMD_PIXEL 0
+#define SH1106_CMD_FILLRECT 1
+#define SH1106_CMD_BITMAP 2
+#define SH1106_CMD_CHAR 3
+
+/*
+An encoded draw command
+*/
+struct SH1106Command
+{
+	uint8_t type;           // SH1106_CMD_*
+	int16_t x;
+	int16_t y;
+	uint8_t w;              // the width of the rectangle/bitmap, or the character
+	uint8_t h;
+	uint8_t color;
+	uint8_t backgroundType;
+	const byte *bitmap;
+};
+
+/*
+A run of ReadModifyWrite columns on a page, collected by SH1106Lib::drainCommands(). Every column is kept as
+an AND and an XOR mask, that the draws are folded into, and that are applied to the display memory together:
+(pixels & and) ^ xor
+*/
+struct SH1106ColumnRun
+{
+	uint8_t x;              // the first column
+	uint8_t page;
+	uint8_t count;          // the number of columns, 0 if the run is empty
+	byte andMask[SH1106_MAXSEGMENTSPERWRITE];
+	byte xorMask[SH1106_MAXSEGMENTSPERWRITE];
+};
+
+/*
+The columns collected by SH1106Lib::drainCommands(), so the commands that fall onto the same page are drawn
+in a single ReadModifyWrite session. There are two runs, so the draws that cross a page boundary (like a text
+that is not aligned to the pages) are collected on both pages.
+*/
+struct SH1106ColumnBatch
+{
+	uint8_t cursor;         // where the next column of the current draw goes
+	uint8_t cursorPage;
+	uint8_t last;           // the run that got the last column
+	SH1106ColumnRun runs[2];
+};
+
+/*
+A fixed size, lock free, single producer/single consumer ring of draw commands
+The producer (typically an ISR) pushes the commands, without touching the I2C bus, and the main context
+draws them with SH1106Lib::drainCommands(). The push methods must only be called from one context,
+and drainCommands() from one other.
+*/
+class SH1106CommandQueue
+{
+public:
+	bool pushPixel(int16_t x, int16_t y, uint8_t color);
+	bool pushFillRect(int16_t left, int16_t top, uint8_t width, uint8_t height, uint8_t color);
+	bool pushBitmap(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType);
+	bool pushChar(int16_t x, int16_t y, uint8_t character, uint8_t color, uint8_t backgroundType);
+
+	bool isEmpty();
+	/**
+		Gets the oldest command, without removing it from the queue (consumer side)
+
+		@param command Where to copy the command
+		@returns false if the queue is empty
+	*/
+	bool peek(SH1106Command &command);
+	/**
+		Removes the oldest command from the queue (consumer side)
+
+		@returns nothing
+	*/
+	void pop();
+
+private:
+	bool _push(uint8_t type, int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType, const byte *bitmap);
+
+	// the indexes wrap around with a mask
+	static_assert(0 == (SH1106_COMMANDQUEUE_SIZE & (SH1106_COMMANDQUEUE_SIZE - 1)), "SH1106_COMMANDQUEUE_SIZE has to be a power of 2");
+	SH1106Command _commands[SH1106_COMMANDQUEUE_SIZE];
+	// _head is only written by the producer, _tail only by the consumer
+	volatile uint8_t _head = 0;
+	volatile uint8_t _tail = 0;
+};
+
+/*
+The line breaks of a text drawn by SH1106Lib::drawTextBox, so drawing it again skips the layout
+The layout is redone, if the text pointer, the width of the box or the font width differs. If the contents
+of the text change, set text to NULL. The lines after the remembered ones are laid out again on every draw,
+starting from next.
+*/
+struct SH1106TextLayout
+{
+	const char *text;  // the text the layout belongs to
+	uint8_t width;     // the width of the box
+	uint8_t fontWidth; // the width of a character, with the gap after it (it depends on the text size too)
+	uint8_t lines;     // the number of remembered lines
+	uint16_t next;     // where the line after the remembered ones starts in the text
+	uint16_t lineStart[SH1106_TEXTLAYOUT_LINES];
+	uint8_t lineLength[SH1106_TEXTLAYOUT_LINES]; // a line is never longer than what fits into the box
+};
+
+/*
+A font with everything setFont() needs to know about it, stored in the program memory (see extras/assetc)
+*/
+struct SH1106Font
+{
+	const unsigned char *data; // the characters, column by column (and page by page in a column)
+	uint8_t width;
+	uint8_t height;
+	int8_t offset;             // the code of the first character
+	uint8_t flags;             // FONT_*
+	uint8_t last;              // the code of the last character, the ones after it are not in the data
+};
+
+/*
+A bitmap with its size, stored in the program memory (see extras/assetc)
+*/
+struct SH1106Bitmap
+{
+	const byte *data;          // the image, page by page (and column by column in a page)
+	uint8_t width;
+	uint8_t height;
+};
+
+/*
+A 16x8 grid of 8x8 pixel tiles, that covers the whole display
+Every cell holds the index of a tile in the tileset, and remembers whether it has changed since it was last
+drawn by SH1106Lib::renderTiles(). The tileset is in the program memory, 8 bytes (columns) per tile.
+*/
+class SH1106TileMap
+{
+	friend class SH1106Lib;
+
+public:
+	SH1106TileMap(const byte *tileset);
+
+	void setTileset(const byte *tileset);
+	void setTile(uint8_t column, uint8_t row, uint8_t tile);
+	uint8_t getTile(uint8_t column, uint8_t row);
+	void fill(uint8_t tile);
+	void invalidate();
+
+private:
+	const byte *_tileset;
+	uint8_t _tiles[SH1106_TILEMAP_ROWS][SH1106_TILEMAP_COLUMNS];
+	// one bit per column for every row, 1 means it has to be drawn
+	uint16_t _dirty[SH1106_TILEMAP_ROWS];
+};
 
 class SH1106Lib : public TinyPrint
 {
@@ -104,23 +391,80 @@ public:
 	void sendCommand(byte c);
 	void sendData(byte data);
 
-	void clearDisplay(void);
-	void fillRect(uint8_t left, uint8_t top, uint8_t width, uint8_t height, uint8_t color);
-	void drawBitmap(uint8_t x, uint8_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType);
-	void drawPixel(uint8_t x, uint8_t y, uint8_t color);
+	void setRotation(uint8_t rotation);
+	uint8_t getRotation();
+	uint8_t getWidth();
+	uint8_t getHeight();
+
+	void invert(bool inverted);
+	void allPixelsOn(bool on);
+	void setContrast(uint8_t contrast);
+	void sleep();
+	void wake();
+#if SH1106_EFFECTS
+	void flash(uint8_t count, uint16_t period);
+	void fadeTo(uint8_t contrast, uint8_t steps, uint16_t duration = 500);
+	bool updateEffects();
+#endif
+
+	void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+	void setOrigin(int16_t x, int16_t y);
+	void setViewport(int16_t x, int16_t y, int16_t w, int16_t h);
+	void resetViewport();
 
-	void setCursor(uint8_t x, uint8_t y);
-	void setFont(const unsigned char *font, uint8_t width, uint8_t height, int8_t offset = 0, uint8_t flags = FONT_FULL);
+	void clearDisplay(void);
+	void fillRect(int16_t left, int16_t top, uint8_t width, uint8_t height, uint8_t color);
+	void fillRectPattern(int16_t left, int16_t top, uint8_t width, uint8_t height, const byte *pattern);
+	static void ditherPattern(uint8_t level, byte *pattern);
+	void drawBitmap(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType);
+	void drawBitmap(int16_t x, int16_t y, const SH1106Bitmap *bitmap, uint8_t color, uint8_t backgroundType);
+	void drawBitmapRowMajor(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType);
+	void drawGrayscaleBitmap(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h);
+	void drawPixel(int16_t x, int16_t y, uint8_t color);
+
+	void setCursor(int16_t x, int16_t y);
+	void setFont(const unsigned char *font, uint8_t width, uint8_t height, int8_t offset = 0, uint8_t flags = FONT_FULL, uint8_t last = 0xFF);
+	void setFont(const SH1106Font *font);
 	void setTextWrap(bool enableWrap);
 	void setTextColor(uint8_t color, uint8_t backgroundType);
+	void setTextSize(uint8_t size);
 	// Inherited via TinyPrint
 	virtual byte write(uint8_t) override;
-	void drawChar(uint8_t x, uint8_t y, uint8_t character, uint8_t color, uint8_t backgroundType);
+	void drawChar(int16_t x, int16_t y, uint8_t character, uint8_t color, uint8_t backgroundType);
+	uint16_t measureText(const char *text);
+	void drawTextBox(int16_t x, int16_t y, uint8_t w, uint8_t h, const char *text, uint8_t align = ALIGN_LEFT, SH1106TextLayout *layout = NULL);
+
+	void readRegion(uint8_t x, uint8_t page, uint8_t w, uint8_t pages, byte *buffer);
+	void writeRegion(uint8_t x, uint8_t page, uint8_t w, uint8_t pages, const byte *buffer);
+	void printScreenshot(TinyPrint &out);
+
+	void drainCommands(SH1106CommandQueue &queue);
+	void renderTiles(SH1106TileMap &map);
+
+	void beginPageWrite(uint8_t x, uint8_t page);
+	void writePageData(byte data);
+	void endPageWrite();
+
+#if SH1106_INCREMENTAL
+	bool queueClearDisplay();
+	bool queueFillRect(int16_t left, int16_t top, uint8_t width, uint8_t height, uint8_t color);
+	bool queueBitmap(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType);
+	bool service(uint16_t maxMicros);
+	bool isIdle();
+#endif
+
+#if SH1106_BUSSTATS
+	const SH1106BusStats& getBusStats();
+	void resetBusStats();
+	static uint32_t modelBusTime(const SH1106BusStats& stats, uint32_t busFrequency);
+#endif
 
 private:
 	void _setDisplayWritePosition(uint8_t x, uint8_t y);
 	void _beginTransmission(byte operation = I2CWRITE, bool startNewTransmission = false);
 	void _endTransmission();
+	void _i2cWrite(byte data);
+	byte _i2cRead(bool last);
 	/**
 		Moves the display write position, and starts the ReadModifyWrite mode
 
@@ -140,12 +484,44 @@ private:
 		Note: the ReadModifyWrite must be enabled for this to work
 
 		@param data The byte that will be output to the column
-		@param color The color that the 1 pixels is displayed should be black or whit - ANDs or ORs the data to the pixels on the screen
-		@param backgroundType The type of the background. Valid values: SOLID, TRANSPARENT
+		@param color The color that the 1 pixels is displayed should be black, white or inverse - ANDs, ORs or XORs the data to the pixels on the screen
+		@param backgroundType The type of the background. Valid values: SOLID, TRANSPARENT (INVERSE always leaves the background alone)
 		@param backgroundMask A byte mask to specify which bits are actually relevant in the data
 		@returns nothing
 	*/
 	void _drawColumn(uint8_t data, uint8_t color, uint8_t backgroundType = TRANSPARENT, byte backgroundMask = B00000000);
+	/**
+		Modifies a single column on the current page: (pixels & andMask) ^ xorMask
+		While drainCommands() collects the columns, it only adds the column to the batch
+		Note: the ReadModifyWrite must be enabled for this to work
+
+		@param andMask The pixels to keep
+		@param xorMask The pixels to flip after that
+		@returns nothing
+	*/
+	void _modifyColumn(byte andMask, byte xorMask);
+	/**
+		Folds a column into the batch of drainCommands(), at the ReadModifyWrite position
+		Draws the batch first, if the column does not fit into it
+
+		@param andMask The pixels to keep
+		@param xorMask The pixels to flip after that
+		@returns nothing
+	*/
+	void _batchColumn(byte andMask, byte xorMask);
+	/**
+		Draws the columns of a run of the batch of drainCommands() in a single ReadModifyWrite session, and empties it
+
+		@param run The run to draw
+		@returns nothing
+	*/
+	void _flushRun(SH1106ColumnRun &run);
+	/**
+		Draws every column collected in the batch of drainCommands()
+
+		@returns nothing
+	*/
+	void _flushBatch();
 	/**
 		Draws a number of columns (same 8bits vertically) on the current page.
 		Note: the ReadModifyWrite must be enabled for this to work
@@ -158,24 +534,377 @@ private:
 		@returns nothing
 	*/
 	void _drawColumns(uint8_t x, uint8_t y, uint8_t data, uint8_t count, uint8_t color);
+	/**
+		Writes zeroes to a number of columns on a page, in one transmission
+
+		@param x The x coordinate 0..127 of the first column
+		@param page The page 0..7
+		@param count How many columns should be cleared
+		@returns nothing
+	*/
+	void _clearColumns(uint8_t x, uint8_t page, uint8_t count);
+	/**
+		Calculates which bits of a page are covered by the rows top..bottom
+
+		@param top The first row
+		@param bottom The last row
+		@param page The page 0..7
+		@returns the mask of the covered bits
+	*/
+	byte _rowMask(uint8_t top, uint8_t bottom, uint8_t page);
+	/**
+		Moves a rectangle by the origin, and cuts it to the clip rectangle
+		This is the only place where the drawing functions are clipped, so it is done before any transmission starts
+
+		@param x The x coordinate of the rectangle, it is replaced by the screen x coordinate (that can be negative)
+		@param y The y coordinate of the rectangle, it is replaced by the screen y coordinate (that can be negative)
+		@param w The width of the rectangle
+		@param h The height of the rectangle
+		@param area Receives the visible part of the rectangle
+		@returns false if no part of the rectangle is visible
+	*/
+	bool _clip(int16_t &x, int16_t &y, uint8_t w, uint8_t h, SH1106ClipArea &area);
+	/**
+		Cuts a region of readRegion() or writeRegion() to the display, so the column pointer never wraps
+		around, and no page is addressed that does not exist
+
+		@param x The x coordinate of the first column
+		@param page The first page
+		@param w The number of columns
+		@param pages The number of pages, it is replaced by the number of pages on the display
+		@returns the number of columns on the display, 0 if no part of the region is on it
+	*/
+	uint8_t _clipRegion(uint8_t x, uint8_t page, uint8_t w, uint8_t &pages);
+	/**
+		Draws the visible part of a bitmap (or a character), in the current rotation
+
+		@param x The screen x coordinate of the bitmap
+		@param y The screen y coordinate of the bitmap
+		@param data The first byte of the bitmap
+		@param columnStride The distance of two columns in the bitmap data
+		@param pageStride The distance of two pages in the bitmap data
+		@param w The width of the bitmap
+		@param h The height of the bitmap
+		@param color The color which the image should be displayed (BLACK/WHITE)
+		@param backgroundType SOLID or TRANSPARENT background
+		@param blank If true, the bitmap data is not read, every pixel is considered 0
+		@param area The visible part of the bitmap (see _clip())
+		@returns nothing
+	*/
+	void _drawImage(int16_t x, int16_t y, const byte *data, uint8_t columnStride, uint8_t pageStride, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType, bool blank, const SH1106ClipArea &area);
+	/**
+		Draws the columns of a bitmap that fall on a single page of the display, in one ReadModifyWrite session
+		Both the page of the bitmap that starts on this page, and the one that hangs into it from above are drawn
+
+		@param x The x coordinate of the bitmap (display coordinates, can be negative)
+		@param y The y coordinate of the bitmap (display coordinates, can be negative)
+		@param data The first byte of the bitmap
+		@param columnStride The distance of two columns in the bitmap data
+		@param pageStride The distance of two pages in the bitmap data
+		@param pages The number of pages in the bitmap
+		@param page The page 0..7 of the display
+		@param left The x coordinate 0..127 of the first column to draw
+		@param count How many columns should be drawn
+		@param mask The rows of the page that belong to the bitmap, and are visible
+		@param color The color which the image should be displayed (BLACK/WHITE)
+		@param backgroundType SOLID or TRANSPARENT background
+		@param blank If true, the bitmap data is not read, every pixel is considered 0
+		@returns nothing
+	*/
+	void _drawImagePage(int16_t x, int16_t y, const byte *data, uint8_t columnStride, uint8_t pageStride, uint8_t pages, uint8_t page, uint8_t left, uint8_t count, byte mask, uint8_t color, uint8_t backgroundType, bool blank);
+	/**
+		Fills the rows top..bottom of a number of columns (in display coordinates)
+
+		@param left The x coordinate 0..127 of the first column
+		@param width How many columns should be filled
+		@param top The first row
+		@param bottom The last row
+		@param color The color of the area
+		@returns nothing
+	*/
+	void _fillArea(uint8_t left, uint8_t width, uint8_t top, uint8_t bottom, uint8_t color);
+	/**
+		Overwrites the visible part of a rectangle with generated columns: a repeating pattern, or a dithered grayscale bitmap
+		The pages that are covered completely are sent in write-only bursts, only the partially covered ones are read back
+
+		@param x The screen x coordinate of the bitmap (not used for the patterns)
+		@param y The screen y coordinate of the bitmap (not used for the patterns)
+		@param w The width of the bitmap (not used for the patterns)
+		@param area The visible part of the rectangle (see _clip())
+		@param columns The pattern, as the columns of the display: column x gets columns[x & 7] (NULL for the bitmap)
+		@param bitmap The grayscale bitmap, one byte per pixel, row by row (NULL for the pattern)
+		@returns nothing
+	*/
+	void _drawShaded(int16_t x, int16_t y, uint8_t w, const SH1106ClipArea &area, const byte *columns, const byte *bitmap);
+	/**
+		Generates the 8 pixels of a display column of a dithered grayscale bitmap (see _drawShaded())
+
+		@param x The screen x coordinate of the bitmap
+		@param y The screen y coordinate of the bitmap
+		@param w The width of the bitmap
+		@param bitmap The grayscale bitmap
+		@param displayX The column 0..127 of the display
+		@param page The page 0..7 of the display
+		@param mask The rows of the page that are inside the visible part of the bitmap, the others are 0
+		@returns the column byte
+	*/
+	byte _ditherColumn(int16_t x, int16_t y, uint8_t w, const byte *bitmap, uint8_t displayX, uint8_t page, byte mask);
+#if SH1106_COMPOSE_BUFFER
+	/**
+		Fills the same bits of a number of columns in the RAM, like _drawColumn() does it on the display
+
+		@param columns The columns, as they were read from the display (4 byte aligned)
+		@param count How many columns should be filled
+		@param data The bits to fill
+		@param color The color of the bits (BLACK/WHITE/INVERSE)
+		@returns nothing
+	*/
+	static void _composeFill(byte *columns, uint8_t count, byte data, uint8_t color);
+	/**
+		Draws a part of a page of a bitmap onto a number of columns in the RAM, like _drawColumn() does it on the display
+
+		@param columns The columns, as they were read from the display (4 byte aligned)
+		@param lower The bitmap page that is shifted down into the columns, from its first column to draw (NULL if there is none)
+		@param upper The bitmap page above it, that hangs into the columns from above (NULL if there is none)
+		@param columnStride The distance of two columns in the bitmap data
+		@param shift How many rows the bitmap is below the top of the columns
+		@param count How many columns should be drawn
+		@param mask The rows of the columns that belong to the bitmap, and are visible
+		@param color The color which the image should be displayed (BLACK/WHITE/INVERSE)
+		@param backgroundType SOLID or TRANSPARENT background
+		@returns nothing
+	*/
+	static void _composeImage(byte *columns, const byte *lower, const byte *upper, uint8_t columnStride, uint8_t shift, uint8_t count, byte mask, uint8_t color, uint8_t backgroundType);
+	/**
+		Checks if a part of a page of a bitmap has all of its bits set, so drawing it covers the columns completely
+
+		@param lower The bitmap page that is shifted down into the columns (NULL if there is none)
+		@param upper The bitmap page above it, that hangs into the columns from above (NULL if there is none)
+		@param columnStride The distance of two columns in the bitmap data
+		@param shift How many rows the bitmap is below the top of the columns
+		@param count How many columns should be checked
+		@returns true if every bit of every column is set
+	*/
+	static bool _composeCovers(const byte *lower, const byte *upper, uint8_t columnStride, uint8_t shift, uint8_t count);
+#endif
+	/**
+		Converts a point to the display coordinates (moved by the origin, clipped and rotated)
+
+		@param x The x coordinate of the point
+		@param y The y coordinate of the point
+		@param displayX Receives the display x coordinate
+		@param displayY Receives the display y coordinate
+		@returns false if the point is not visible
+	*/
+	bool _toDisplay(int16_t x, int16_t y, uint8_t &displayX, uint8_t &displayY);
+	/**
+		Draws a bitmap (or a character) in the 90 and 270 degrees rotations
+		The bitmap is processed in 8x8 blocks, that are transposed, so every block is still written as whole column bytes
+
+		@param x The screen x coordinate of the bitmap (rotated coordinates)
+		@param y The screen y coordinate of the bitmap (rotated coordinates)
+		@param data The first byte of the bitmap
+		@param columnStride The distance of two columns in the bitmap data
+		@param pageStride The distance of two pages in the bitmap data
+		@param w The width of the bitmap
+		@param h The height of the bitmap
+		@param color The color which the image should be displayed (BLACK/WHITE)
+		@param backgroundType SOLID or TRANSPARENT background
+		@param blank If true, the bitmap data is not read, every pixel is considered 0
+		@param area The visible part of the bitmap (see _clip())
+		@param scaled If true, data is a character of the font, that is scaled up by the text size while it is read (w and h are the scaled size)
+		@returns nothing
+	*/
+	void _drawTransposed(int16_t x, int16_t y, const byte *data, uint8_t columnStride, uint8_t pageStride, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType, bool blank, const SH1106ClipArea &area, bool scaled = false);
+	/**
+		Transposes an 8x8 pixel block in place: bit k of byte r becomes bit r of byte k
+
+		@param block The 8 bytes of the block
+		@returns nothing
+	*/
+	static void _transpose8(byte *block);
+	/**
+		Reverses the order of the bits in a byte
+
+		@param b The byte
+		@returns the reversed byte
+	*/
+	static byte _reverseBits(byte b);
+	/**
+		Reads an 8x8 pixel block of a row-major (MSB first) bitmap, and transposes it to column bytes
+		The column c of the block ends up in block[7 - c], the rows below the bitmap are 0
+
+		@param bitmap The bitmap
+		@param stride The number of bytes in a row of the bitmap
+		@param h The height of the bitmap
+		@param page Which 8 rows to read (can be outside of the bitmap, then the block is empty)
+		@param column Which 8 columns to read (the byte index in the row)
+		@param block Receives the 8 column bytes
+		@returns nothing
+	*/
+	static void _readRowMajorBlock(const byte *bitmap, uint8_t stride, uint8_t h, int16_t page, uint8_t column, byte *block);
+	/**
+		Draws the columns of a row-major bitmap that fall on a single page of the display, in one ReadModifyWrite session
+
+		@param x The x coordinate of the bitmap (display coordinates, can be negative)
+		@param y The y coordinate of the bitmap (display coordinates, can be negative)
+		@param bitmap The bitmap
+		@param w The width of the bitmap
+		@param h The height of the bitmap
+		@param page The page 0..7 of the display
+		@param left The x coordinate 0..127 of the first column to draw
+		@param count How many columns should be drawn
+		@param mask The rows of the page that belong to the bitmap, and are visible
+		@param color The color which the image should be displayed (BLACK/WHITE/INVERSE)
+		@param backgroundType SOLID or TRANSPARENT background
+		@returns nothing
+	*/
+	void _drawRowMajorPage(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t page, uint8_t left, uint8_t count, byte mask, uint8_t color, uint8_t backgroundType);
+	/**
+		Draws the part of a row-major bitmap that falls on a single page of the display, in the 90 and 270 degrees rotations
+		The rows of the bitmap are the columns of the display then, so only their bit order has to be reversed
+
+		@param x The screen x coordinate of the bitmap (rotated coordinates)
+		@param y The screen y coordinate of the bitmap (rotated coordinates)
+		@param bitmap The bitmap
+		@param w The width of the bitmap
+		@param page The page 0..7 of the display
+		@param area The visible part of the bitmap (see _clip())
+		@param color The color which the image should be displayed (BLACK/WHITE/INVERSE)
+		@param backgroundType SOLID or TRANSPARENT background
+		@returns nothing
+	*/
+	void _drawRowMajorRows(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t page, const SH1106ClipArea &area, uint8_t color, uint8_t backgroundType);
+	/**
+		Finds where a line of text has to be broken, preferably at a word boundary
+
+		@param text The text
+		@param start Where the line starts in the text
+		@param capacity How many characters fit into the line
+		@param length Returns how many characters of the line should be drawn
+		@returns where the next line starts in the text
+	*/
+	uint16_t _breakLine(const char *text, uint16_t start, uint8_t capacity, uint8_t &length);
+	/**
+		Gets a page of a character column, scaled up by the text size: the column is spread vertically, so every bit is repeated size times
+
+		@param column The column of the character
+		@param page The page of the scaled column (0..byteHeight * size - 1)
+		@returns the 8 bits of the scaled column on the page
+	*/
+	byte _scaledByte(const byte *column, uint8_t page);
+	/**
+		Draws the columns of a scaled character that fall on a single page of the display, in one ReadModifyWrite session
+		Every column of the character is drawn size times
+
+		@param x The x coordinate of the character (display coordinates, can be negative)
+		@param y The y coordinate of the character (display coordinates, can be negative)
+		@param glyph The first column of the character in the font
+		@param byteHeight The number of pages in a column of the font
+		@param page The page 0..7 of the display
+		@param left The x coordinate 0..127 of the first column to draw
+		@param count How many columns should be drawn
+		@param mask The rows of the page that belong to the character, and are visible
+		@param color The color of the character (BLACK/WHITE/INVERSE)
+		@param backgroundType SOLID or TRANSPARENT background
+		@param blank If true, the font data is not read, every pixel is considered 0
+		@returns nothing
+	*/
+	void _drawScaledPage(int16_t x, int16_t y, const byte *glyph, uint8_t byteHeight, uint8_t page, uint8_t left, uint8_t count, byte mask, uint8_t color, uint8_t backgroundType, bool blank);
+#if SH1106_INCREMENTAL
+	/**
+		Executes the next step (at most SH1106_JOBSTEP_SIZE columns on one page, or on every page for a transposed bitmap) of a queued drawing operation
+
+		@param job The operation to advance
+		@returns true if the operation is finished
+	*/
+	bool _stepJob(SH1106Job &job);
+	/**
+		Puts a drawing operation at the end of the queue
+
+		@param type SH1106_JOB_*
+		@param x Where the bitmap starts
+		@param y Where the bitmap starts
+		@param w The width of the bitmap
+		@param h The height of the bitmap
+		@param area The visible part, already clipped
+		@param color The color to draw with
+		@param backgroundType SOLID or TRANSPARENT
+		@param bitmap The bitmap in the program memory, or NULL
+		@returns false if the queue is full
+	*/
+	bool _queueJob(uint8_t type, int16_t x, int16_t y, uint8_t w, uint8_t h, const SH1106ClipArea &area, uint8_t color, uint8_t backgroundType, const byte *bitmap);
+#endif
+	/**
+		Sends a command with an argument, in its own transmission
+
+		@param command The command
+		@param argument The byte that follows the command
+		@returns nothing
+	*/
+	void _sendCommandArgument(byte command, byte argument);
 
 	// text related variables
-	uint8_t _cursorX = 0;
-	uint8_t _cursorY = 0;
+	int16_t _cursorX = 0;
+	int16_t _cursorY = 0;
 	uint8_t _textColor = WHITE;
 	uint8_t _backgroundType = TRANSPARENT;
 	uint8_t _fontWidth = 5;
 	uint8_t _fontHeight = 8;
 	int8_t _fontOffset = 0;
 	uint8_t _fontFlags = FONT_FULL;
+	uint8_t _fontLast = 0xFF;
+	uint8_t _textSize = 1;
 	bool _wrap = true;
 	const unsigned char* _font;
+	// everything is clipped to this (the right and the bottom are not included), drawTextBox narrows it to its box
+	uint8_t _clipLeft = 0;
+	uint8_t _clipTop = 0;
+	uint8_t _clipRight = SH1106_LCDWIDTH;
+	uint8_t _clipBottom = SH1106_LCDHEIGHT;
+	// added to the coordinates of everything that is drawn
+	int16_t _originX = 0;
+	int16_t _originY = 0;
+
+	// orientation
+	uint8_t _rotation = 0;
+	uint8_t _width = SH1106_LCDWIDTH;
+	uint8_t _height = SH1106_LCDHEIGHT;
+
+#if SH1106_EFFECTS
+	// display effects
+	uint8_t _contrast = 0x9F;
+	bool _inverted = false;
+	// how many times the inversion has to be toggled by the running flash, it is shown flipped while this is odd
+	uint8_t _flashToggles = 0;
+	uint16_t _flashHalfPeriod;
+	unsigned long _flashTime;
+	uint8_t _fadeFrom;
+	uint8_t _fadeTarget;
+	uint8_t _fadeSteps = 0;
+	// the running fade is done, when this reaches _fadeSteps
+	uint8_t _fadeStep = 0;
+	uint16_t _fadeStepTime;
+	unsigned long _fadeTime;
+#endif
 
 	uint8_t _pixelPosX = 0;
 	uint8_t _pixelPosY = 0;
 
 	// i2c vars
 	bool _i2cTransmissionInProgress = false;
+	// the columns collected by drainCommands(), NULL when the draws go straight to the display
+	SH1106ColumnBatch *_batch = NULL;
+#if SH1106_BUSSTATS
+	SH1106BusStats _busStats = { 0, 0, 0, 0 };
+#endif
+
+#if SH1106_INCREMENTAL
+	// queued drawing operations
+	SH1106Job _jobs[SH1106_JOBQUEUE_SIZE];
+	uint8_t _jobHead = 0;
+	uint8_t _jobCount = 0;
+#endif
 };
 
 
@@ -216,8 +945,9 @@ void SH1106Lib::initialize()
 	sendCommand(0x10);
 	sendCommand(SH1106_MEMORYMODE);                    // 0x20
 	sendCommand(0x00);                                  // 0x0 act like ks0108
-	sendCommand(SH1106_SEGREMAP | 0x1);
-	sendCommand(SH1106_COMSCANDEC);
+	// the orientation of the panel (180 degrees is done by the hardware)
+	sendCommand(SH1106_SEGREMAP | ((_rotation & 2) ? 0x0 : 0x1));
+	sendCommand((_rotation & 2) ? SH1106_COMSCANINC : SH1106_COMSCANDEC);
 	sendCommand(SH1106_SETCOMPINS);                    // 0xDA
 	sendCommand(0x12);
 	sendCommand(SH1106_SETCONTRAST);                   // 0x81
@@ -240,6 +970,15 @@ void SH1106Lib::initialize()
 	sendCommand(SH1106_SETSTARTLINE | 0x0); // line #0
 
 	_endTransmission();
+
+	// the column address set above is off screen, so the next draw has to set the position
+	_pixelPosX = 0xFF;
+#if SH1106_EFFECTS
+	_contrast = 0x9F;
+	_inverted = false;
+	_flashToggles = 0;
+	_fadeStep = _fadeSteps = 0;
+#endif
 }
 
 /*
@@ -251,8 +990,8 @@ void SH1106Lib::sendCommand(byte command)
 	// I2C
 	_beginTransmission(I2CWRITE, false);
 
-	i2c_write(SH1106_MESSAGETYPE_COMMAND); // This is a Command 
-	i2c_write(command);
+	_i2cWrite(SH1106_MESSAGETYPE_COMMAND); // This is a Command 
+	_i2cWrite(command);
 
 	//if (useOwnTransmission)
 	//{
@@ -269,8 +1008,8 @@ void SH1106Lib::sendData(byte data)
 	// I2C
 	_beginTransmission(I2CWRITE, false);
 
-	i2c_write(SH1106_MESSAGETYPE_DATA); // This byte is DATA 
-	i2c_write(data);
+	_i2cWrite(SH1106_MESSAGETYPE_DATA); // This byte is DATA 
+	_i2cWrite(data);
 
 	//if (useOwnTransmission)
 	//{
@@ -280,187 +1019,489 @@ void SH1106Lib::sendData(byte data)
 
 
 /*
-Clears the display
+Sets the orientation of the drawing
+The 180 degrees rotation is done by the display itself, so it costs nothing. The 90 and 270 degrees rotations
+swap the width and the height; the bitmaps and the characters are transposed in 8x8 blocks while drawing.
+Note: only the drawing that comes after this is affected, the operations queued before keep their orientation.
+The tile maps and the page writes always use the 0 (or the 180) degrees coordinates.
+rotation: 0: 0 degrees, 1: 90 degrees, 2: 180 degrees, 3: 270 degrees
 */
-void SH1106Lib::clearDisplay(void)
+void SH1106Lib::setRotation(uint8_t rotation)
 {
-	uint8_t page, segments, parts;
-	//byte buffer[16] = { 0x00 };
-
-	_beginTransmission(I2CWRITE, true);
-	// clear the buffer so we can fill the screen with zeroes
-	for (page = 0; page < SH1106_NUMBEROF_PAGES; page++)
-	{
-		// move to the beginning of the next page
-		_setDisplayWritePosition(0, page * SH1106_ROWHEIGHT);
-		for (segments = 0; segments < (SH1106_NUMBEROF_SEGMENTS / SH1106_MAXSEGMENTSPERWRITE); segments++)
-		{
-			// no need to set the draw position, as every memory write advances the write pos to the next one
-			for (parts = 0; parts < SH1106_MAXSEGMENTSPERWRITE; parts++)
-			{
-				sendData(0x00);
-			}
-			//sendData(buffer, SH1106_MAXSEGMENTSPERWRITE, false);
-		}
+	rotation &= 3;
+	bool flip = (rotation & 2) != (_rotation & 2);
+
+	_rotation = rotation;
+	_width = (rotation & 1) ? SH1106_LCDHEIGHT : SH1106_LCDWIDTH;
+	_height = (rotation & 1) ? SH1106_LCDWIDTH : SH1106_LCDHEIGHT;
+	// the old viewport does not mean anything in the new orientation
+	resetViewport();
+
+	if (flip)
+	{ // flip the segment and the COM scan directions
+		_beginTransmission(I2CWRITE, true);
+		sendCommand(SH1106_SEGREMAP | ((rotation & 2) ? 0x0 : 0x1));
+		sendCommand((rotation & 2) ? SH1106_COMSCANINC : SH1106_COMSCANDEC);
+		_endTransmission();
 	}
-	_endTransmission();
 }
 
-//unsigned char reverse(unsigned char b) {
-//	b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
-//	b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
-//	b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
-//	return b;
-//}
-//
-//char* printBits(byte myByte) {
-//	static char str[9];
-//	byte mask = 0x80;
-//
-//	for (uint8_t i = 0; i < 8; i++)
-//	{
-//		if (mask & myByte)
-//		{
-//			str[i] = '1';
-//		}
-//		else
-//		{
-//			str[i] = '0';
-//		}
-//		mask >>= 1;
-//	}
-//	str[8] = '\0';
-//
-//	return str;
-//}
-
 /*
-Displays a filled rectangle
-left: x coordinate of the top left corner of the rectangle
-top: y coordinate of the top left corner of the rectangle
-width: width of the rectangle
-height: height of the rectangle
-color: color of the rectangle
+Gets the orientation of the drawing
+
+returns: 0: 0 degrees, 1: 90 degrees, 2: 180 degrees, 3: 270 degrees
 */
-void SH1106Lib::fillRect(uint8_t left, uint8_t top, uint8_t width, uint8_t height, uint8_t color)
+uint8_t SH1106Lib::getRotation()
 {
-	// sanity check
-	if (left > SH1106_LCDWIDTH || top > SH1106_LCDHEIGHT)
-	{
-		return;
-	}
-	if (left + width > SH1106_LCDWIDTH)
-	{
-		width = SH1106_LCDWIDTH - left;
-	}
-	if (top + height > SH1106_LCDHEIGHT)
-	{
-		height = SH1106_LCDHEIGHT - top - 1;
-	}
-
-	uint8_t i = 0;
-	byte maskStart, maskEnd = B00000000;
+	return _rotation;
+}
 
-	// calculate the start and the end masks
-	maskStart = B11111111 << ((top % 8));
-	maskEnd = ~(B11111111 << (((top + height) % 8) + 1));
+/*
+Gets the width of the drawing area (it depends on the rotation)
 
-	if (height <= 8 && (floor(top / 8) == floor((top + height) / 8)))
-	{ // smaller than a page, so combine the start and the end mask
-		maskStart = maskStart & maskEnd;
-	}
-	else
-	{
-		// write the end mask to the last page it touches
-		_drawColumns(left, top + height, maskEnd, width, color);
-	}
+returns: the width in pixels
+*/
+uint8_t SH1106Lib::getWidth()
+{
+	return _width;
+}
 
-	// write the start mask
-	_drawColumns(left, top, maskStart, width, color);
+/*
+Gets the height of the drawing area (it depends on the rotation)
 
-	if (height > 8)
-	{ // larger than 8
-	  // loop through the inner parts
-		for (i = top + (8 - (top % 8)); i < top + height - ((top + height) % 8); i += 8)
-		{
-			_drawColumns(left, i, B11111111, width, color);
-		}
-	}
+returns: the height in pixels
+*/
+uint8_t SH1106Lib::getHeight()
+{
+	return _height;
 }
 
 /*
-Draws a bitmap from the program memory to the display
-x: the x coordinate to put the bitmap
-y: the y coordiante to put the bitmap
-bitmap: the byte array representing the image
-w: the width of the image
-h: the height of the image
-color: the color which the image should be displayed (BLACK/WHITE)
-backgroundType: SOLID or TRANSPARENT background
+Inverts the whole display (the lit pixels go dark, and the dark ones light up), without touching the display memory
+inverted: true to invert, false to go back to normal
 */
-void SH1106Lib::drawBitmap(uint8_t x, uint8_t y, const byte * bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType = SOLID)
+void SH1106Lib::invert(bool inverted)
 {
-	if (w > SH1106_LCDWIDTH || h > SH1106_LCDHEIGHT)
-	{ // sanity check
-		return;
-	}
+#if SH1106_EFFECTS
+	_inverted = inverted;
+	// a running flash keeps going, on top of the new state
+	inverted ^= (_flashToggles & 1);
+#endif
+	_beginTransmission(I2CWRITE, true);
+	sendCommand(inverted ? SH1106_INVERTDISPLAY : SH1106_NORMALDISPLAY);
+	_endTransmission();
+}
 
-	uint8_t i, j, n, diff, yActual;
-	uint8_t actualByte = 0x00;
+/*
+Lights up every pixel of the display, regardless of the display memory (that is left intact)
+on: true to light up every pixel, false to show the display memory again
+*/
+void SH1106Lib::allPixelsOn(bool on)
+{
+	_beginTransmission(I2CWRITE, true);
+	sendCommand(on ? SH1106_DISPLAYALLON : SH1106_DISPLAYALLON_RESUME);
+	_endTransmission();
+}
+
+/*
+Sets the contrast (the brightness) of the display
+contrast: 0..255, initialize() sets it to 159
+*/
+void SH1106Lib::setContrast(uint8_t contrast)
+{
+#if SH1106_EFFECTS
+	_contrast = contrast;
+	// it overrides a running fade
+	_fadeStep = _fadeSteps;
+#endif
+	_sendCommandArgument(SH1106_SETCONTRAST, contrast);
+}
+
+/*
+Turns the panel off. The display memory is kept, and can still be drawn to
+*/
+void SH1106Lib::sleep()
+{
+	_beginTransmission(I2CWRITE, true);
+	sendCommand(SH1106_DISPLAYOFF);
+	_endTransmission();
+}
+
+/*
+Turns the panel back on, after sleep()
+*/
+void SH1106Lib::wake()
+{
+	_beginTransmission(I2CWRITE, true);
+	sendCommand(SH1106_DISPLAYON);
+	_endTransmission();
+}
+
+#if SH1106_EFFECTS
+/*
+Starts flashing the display by inverting it, updateEffects() does the rest. The state set by invert() is restored at the end
+count: how many times to flash
+period: the length of one flash (inverted and back) in milliseconds
+*/
+void SH1106Lib::flash(uint8_t count, uint16_t period)
+{
+	if (count > 127)
+	{
+		count = 127;
+	}
+	// the first toggle is done right now (0 stops the running flash)
+	_flashToggles = (0 == count) ? 0 : count * 2 - 1;
+	_flashHalfPeriod = period / 2;
+	_flashTime = millis();
+	invert(_inverted);
+}
 
-	//uint8_t startSize = 8 - (y % 8);
-	//uint8_t endSize = (y + h) % 8;
+/*
+Starts changing the contrast gradually, updateEffects() does the steps
+contrast: the contrast at the end of the fade
+steps: how many steps to take, a step is a single contrast command
+duration: how long the fade takes in milliseconds (half a second by default)
+*/
+void SH1106Lib::fadeTo(uint8_t contrast, uint8_t steps, uint16_t duration/* = 500*/)
+{
+	if (0 == steps)
+	{
+		steps = 1;
+	}
+	_fadeFrom = _contrast;
+	_fadeTarget = contrast;
+	_fadeSteps = steps;
+	_fadeStep = 0;
+	_fadeStepTime = duration / steps;
+	_fadeTime = millis();
+}
+
+/*
+Advances the running flash and fade, call it from the loop. Only sends something, when it is time for the next step
 
-	// height / 8, because we will plot in columns with the height of 8
-	for (j = 0; j < intCeil(h, 8) /*ceil(h / 8.0)*/; j++) {
-		// calculate the start pos
-		diff = (y + j * 8) % 8;
-		for (n = 0; n < ((0 == diff) ? 1 : 2); n++) // if it starts on the page border, then we can do it in one run
+returns: true if there is no effect running
+*/
+bool SH1106Lib::updateEffects()
+{
+	unsigned long now = millis();
+
+	// catch up with every toggle that is due, but only send the last state
+	if (0 != _flashToggles && (now - _flashTime) >= _flashHalfPeriod)
+	{
+		while (0 != _flashToggles && (now - _flashTime) >= _flashHalfPeriod)
 		{
-			yActual = y + ((j + n) * 8);
-			if (yActual > SH1106_LCDHEIGHT)
-			{ // don't try to write outside the display area
-				continue;
-			}
-			_startRMWMode(x, y + ((j + n) * 8));
-			// loop through the width of the image, and plot the columns
-			for (i = 0; i < w; i++) {
-				if ((x + i) > SH1106_LCDWIDTH)
-				{ // don't try to write outside the display area
-					continue;
-				}
-				actualByte = pgm_read_byte(bitmap + (i + (j * w)));
-				if (0 == n)
-				{ // this is the below the page barrier
-					actualByte = actualByte << diff;
-				}
-				else
-				{ // this is the leftover - this only comes in play when the current part of the image crosses the page boundary
-					actualByte = actualByte >> (8 - diff);
-				}
-				// display the column of pixels
-				_drawColumn(actualByte, color, backgroundType, B11111111);
+			_flashToggles--;
+			_flashTime += _flashHalfPeriod;
+		}
+		invert(_inverted);
+	}
+
+	if (_fadeStep < _fadeSteps && (now - _fadeTime) >= _fadeStepTime)
+	{
+		while (_fadeStep < _fadeSteps && (now - _fadeTime) >= _fadeStepTime)
+		{
+			_fadeStep++;
+			_fadeTime += _fadeStepTime;
+		}
+		_contrast = _fadeFrom + ((int16_t)_fadeTarget - _fadeFrom) * _fadeStep / _fadeSteps;
+		_sendCommandArgument(SH1106_SETCONTRAST, _contrast);
+	}
+
+	return (0 == _flashToggles) && (_fadeStep >= _fadeSteps);
+}
+#endif
+
+/*
+Sets the clip rectangle, nothing is drawn outside of it (except by the tile maps and the page writes)
+The coordinates are screen coordinates, the origin does not move the clip rectangle.
+x: x coordinate of the top left corner of the rectangle
+y: y coordinate of the top left corner of the rectangle
+w: width of the rectangle
+h: height of the rectangle
+*/
+void SH1106Lib::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	// only the part that is on the display counts
+	_clipLeft = constrain(x, 0, _width);
+	_clipTop = constrain(y, 0, _height);
+	_clipRight = constrain(x + w, _clipLeft, _width);
+	_clipBottom = constrain(y + h, _clipTop, _height);
+}
+
+/*
+Sets the origin, it is added to the coordinates of everything that is drawn after this
+x: the screen x coordinate of the origin
+y: the screen y coordinate of the origin
+*/
+void SH1106Lib::setOrigin(int16_t x, int16_t y)
+{
+	_originX = x;
+	_originY = y;
+}
+
+/*
+Confines the drawing to a region of the screen: moves the origin to its top left corner, and clips to it
+x: x coordinate of the top left corner of the region
+y: y coordinate of the top left corner of the region
+w: width of the region
+h: height of the region
+*/
+void SH1106Lib::setViewport(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	setOrigin(x, y);
+	setClipRect(x, y, w, h);
+}
+
+/*
+Moves the origin back to the top left corner of the screen, and clips to the whole screen
+*/
+void SH1106Lib::resetViewport()
+{
+	setViewport(0, 0, _width, _height);
+}
+
+/*
+Clears the display
+*/
+void SH1106Lib::clearDisplay(void)
+{
+	uint8_t page;
+
+	// clear the buffer so we can fill the screen with zeroes
+	for (page = 0; page < SH1106_NUMBEROF_PAGES; page++)
+	{
+		_clearColumns(0, page, SH1106_NUMBEROF_SEGMENTS);
+	}
+}
+
+//unsigned char reverse(unsigned char b) {
+//	b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+//	b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+//	b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
+//	return b;
+//}
+//
+//char* printBits(byte myByte) {
+//	static char str[9];
+//	byte mask = 0x80;
+//
+//	for (uint8_t i = 0; i < 8; i++)
+//	{
+//		if (mask & myByte)
+//		{
+//			str[i] = '1';
+//		}
+//		else
+//		{
+//			str[i] = '0';
+//		}
+//		mask >>= 1;
+//	}
+//	str[8] = '\0';
+//
+//	return str;
+//}
+
+/*
+Fills a rectangle with a repeating 8x8 pattern: the lit bits of the pattern are white, the others are black
+The pattern is aligned to the screen, so neighbouring rectangles continue it. The pages that are covered
+completely are written without reading them back
+left: x coordinate of the top left corner of the rectangle
+top: y coordinate of the top left corner of the rectangle
+width: width of the rectangle
+height: height of the rectangle
+pattern: 8 columns of 8 pixels (in the RAM, the least significant bit is the top one), screen column x gets pattern[x & 7] (see ditherPattern())
+*/
+void SH1106Lib::fillRectPattern(int16_t left, int16_t top, uint8_t width, uint8_t height, const byte *pattern)
+{
+	SH1106ClipArea area;
+	byte columns[8];
+	byte swap;
+	uint8_t i;
+
+	if (!_clip(left, top, width, height, area))
+	{ // nothing is visible
+		return;
+	}
+
+	if (_rotation & 1)
+	{ // the rows of the pattern are the columns of the display, and the screen y goes from the right to the left
+		memcpy(columns, pattern, 8);
+		_transpose8(columns);
+		for (i = 0; i < 4; i++)
+		{
+			swap = columns[i];
+			columns[i] = columns[7 - i];
+			columns[7 - i] = swap;
+		}
+		_drawShaded(0, 0, 0, area, columns, NULL);
+		return;
+	}
+
+	_drawShaded(0, 0, 0, area, pattern, NULL);
+}
+
+/*
+Makes an ordered dither pattern for fillRectPattern(), that lights up level / 64 of the pixels evenly
+level: 0 (black) .. 64 (white), SH1106_DITHER_LEVELS / 2 is the checkerboard
+pattern: receives the 8 columns of the pattern
+*/
+void SH1106Lib::ditherPattern(uint8_t level, byte *pattern)
+{
+	uint8_t i, j;
+
+	for (i = 0; i < 8; i++)
+	{
+		pattern[i] = 0x00;
+		for (j = 0; j < 8; j++)
+		{
+			if (pgm_read_byte(&SH1106_BAYER[j][i]) < level)
+			{
+				pattern[i] |= 1 << j;
 			}
-			_stopRMWMode();
 		}
 	}
 }
 
+/*
+Displays a filled rectangle
+left: x coordinate of the top left corner of the rectangle
+top: y coordinate of the top left corner of the rectangle
+width: width of the rectangle
+height: height of the rectangle
+color: color of the rectangle
+*/
+void SH1106Lib::fillRect(int16_t left, int16_t top, uint8_t width, uint8_t height, uint8_t color)
+{
+	SH1106ClipArea area;
+
+	if (!_clip(left, top, width, height, area))
+	{ // nothing is visible
+		return;
+	}
+
+	if (_rotation & 1)
+	{ // the rows of the rectangle are columns on the display
+		_fillArea(SH1106_LCDWIDTH - 1 - area.bottom, area.bottom - area.top + 1, area.left, area.right, color);
+		return;
+	}
+
+	_fillArea(area.left, area.right - area.left + 1, area.top, area.bottom, color);
+}
+
+/*
+Draws a bitmap from the program memory to the display
+x: the x coordinate to put the bitmap
+y: the y coordiante to put the bitmap
+bitmap: the byte array representing the image
+w: the width of the image
+h: the height of the image
+color: the color which the image should be displayed (BLACK/WHITE/INVERSE)
+backgroundType: SOLID or TRANSPARENT background
+*/
+void SH1106Lib::drawBitmap(int16_t x, int16_t y, const byte * bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType = SOLID)
+{
+	SH1106ClipArea area;
+
+	if (!_clip(x, y, w, h, area))
+	{ // nothing is visible
+		return;
+	}
+
+	_drawImage(x, y, bitmap, 1, w, w, h, color, backgroundType, false, area);
+}
+
+/*
+Draws a bitmap, that knows its own size, from the program memory to the display
+x: the x coordinate to put the bitmap
+y: the y coordiante to put the bitmap
+bitmap: the bitmap (in the program memory)
+color: the color which the image should be displayed (BLACK/WHITE/INVERSE)
+backgroundType: SOLID or TRANSPARENT background
+*/
+void SH1106Lib::drawBitmap(int16_t x, int16_t y, const SH1106Bitmap *bitmap, uint8_t color, uint8_t backgroundType)
+{
+	SH1106Bitmap header;
+
+	memcpy_P(&header, bitmap, sizeof(SH1106Bitmap));
+	drawBitmap(x, y, header.data, header.width, header.height, color, backgroundType);
+}
+
+/*
+Draws a row-major bitmap from the program memory to the display, in the format most icon sets and the Adafruit GFX
+library use: every row starts on a new byte, and the leftmost pixel is the most significant bit
+8 rows are read at a time and transposed to columns, so it is drawn in the same column runs as drawBitmap()
+x: the x coordinate to put the bitmap
+y: the y coordiante to put the bitmap
+bitmap: the byte array representing the image ((w + 7) / 8 bytes per row)
+w: the width of the image
+h: the height of the image
+color: the color which the image should be displayed (BLACK/WHITE/INVERSE)
+backgroundType: SOLID or TRANSPARENT background
+*/
+void SH1106Lib::drawBitmapRowMajor(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType)
+{
+	SH1106ClipArea area;
+	uint8_t page;
+
+	if (!_clip(x, y, w, h, area))
+	{ // nothing is visible
+		return;
+	}
+
+	if (_rotation & 1)
+	{ // the screen x goes down on the display, so the pages are made of the screen columns
+		for (page = area.left >> 3; page <= (area.right >> 3); page++)
+		{
+			_drawRowMajorRows(x, y, bitmap, w, page, area, color, backgroundType);
+		}
+		return;
+	}
+
+	for (page = area.top >> 3; page <= (area.bottom >> 3); page++)
+	{
+		_drawRowMajorPage(x, y, bitmap, w, h, page, area.left, area.right - area.left + 1, _rowMask(area.top, area.bottom, page), color, backgroundType);
+	}
+}
+
+/*
+Draws a grayscale bitmap from the program memory to the display, with an 8x8 ordered (Bayer) dither
+It overwrites the area of the bitmap; the pages that are covered completely are written without reading them back
+The dither is aligned to the screen, so a gray level looks the same as the same level of ditherPattern()
+x: the x coordinate to put the bitmap
+y: the y coordiante to put the bitmap
+bitmap: one byte per pixel (0: black .. 255: white), row by row
+w: the width of the image
+h: the height of the image
+*/
+void SH1106Lib::drawGrayscaleBitmap(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h)
+{
+	SH1106ClipArea area;
+
+	if (!_clip(x, y, w, h, area))
+	{ // nothing is visible
+		return;
+	}
+
+	_drawShaded(x, y, w, area, NULL, bitmap);
+}
+
 /*
 Draws a single pixel on th display
 x: the x coordinate to put the pixel
 y: the y coordiante to put the pixel
 color: the color of the pixel
 */
-void SH1106Lib::drawPixel(uint8_t x, uint8_t y, uint8_t color)
+void SH1106Lib::drawPixel(int16_t x, int16_t y, uint8_t color)
 {
-	if (x < 0 || x > SH1106_LCDWIDTH
-		|| y < 0 || y > SH1106_LCDHEIGHT)
+	uint8_t displayX, displayY;
+
+	if (!_toDisplay(x, y, displayX, displayY))
 	{
 		return;
 	}
 
-	_drawColumns(x, y, 1 << (y & 7), 1, color);
+	_drawColumns(displayX, displayY, 1 << (displayY & 7), 1, color);
 }
 
 /*
@@ -468,7 +1509,7 @@ Sets the text cursor to this position
 x: the x coordinate
 y: the y coordiante
 */
-void SH1106Lib::setCursor(uint8_t x, uint8_t y)
+void SH1106Lib::setCursor(int16_t x, int16_t y)
 {
 	_cursorX = x;
 	_cursorY = y;
@@ -481,14 +1522,28 @@ width: the width of the font in pixels
 height: the height of the font in pixels
 offset: signed value to offset the position the character is found in the font
 flags: set of flags describing the properties of the font
+last: the code of the last character in the font, the characters after it (and before offset) are not drawn
 */
-void SH1106Lib::setFont(const unsigned char *font, uint8_t width, uint8_t height, int8_t offset/* = 0*/, uint8_t flags/* = FONT_FULL*/)
+void SH1106Lib::setFont(const unsigned char *font, uint8_t width, uint8_t height, int8_t offset/* = 0*/, uint8_t flags/* = FONT_FULL*/, uint8_t last/* = 0xFF*/)
 {
 	_font = font;
 	_fontWidth = width;
 	_fontHeight = height;
 	_fontOffset = offset;
 	_fontFlags = flags;
+	_fontLast = last;
+}
+
+/*
+Sets the font to write with, from a font that knows its own properties
+font: the font (in the program memory)
+*/
+void SH1106Lib::setFont(const SH1106Font *font)
+{
+	SH1106Font header;
+
+	memcpy_P(&header, font, sizeof(SH1106Font));
+	setFont(header.data, header.width, header.height, header.offset, header.flags, header.last);
 }
 
 /*
@@ -511,6 +1566,16 @@ void SH1106Lib::setTextColor(uint8_t color, uint8_t backgroundType)
 	_backgroundType = backgroundType;
 }
 
+/*
+Sets how many times the characters are scaled up, both horizontally and vertically. The font is scaled while drawing,
+so the big characters need no extra font data
+size: 1..4 (SH1106_MAX_TEXTSIZE), 1 is the original size
+*/
+void SH1106Lib::setTextSize(uint8_t size)
+{
+	_textSize = constrain(size, 1, SH1106_MAX_TEXTSIZE);
+}
+
 /*
 Displays a single character
 c: the character to display
@@ -520,7 +1585,7 @@ returns: 1
 byte SH1106Lib::write(uint8_t c)
 {
 	if (c == '\n') { // on a linebreak move the cursor down one line, and back to the start
-		setCursor(0, _cursorY + _fontHeight);
+		setCursor(0, _cursorY + _fontHeight * _textSize);
 	}
 	else if (c == '\r') {
 		// skip carrage return, as we already handle newline
@@ -529,11 +1594,11 @@ byte SH1106Lib::write(uint8_t c)
 		// draw the pixels for the actual character
 		drawChar(_cursorX, _cursorY, c, _textColor, _backgroundType);
 		// advance the cursor
-		setCursor(_cursorX + _fontWidth + 1, _cursorY);
+		setCursor(_cursorX + (_fontWidth + 1) * _textSize, _cursorY);
 		// if the next letter would not fit in the current row, jump to the beginnign of the next one
-		if (_wrap && (_cursorX > (SH1106_LCDWIDTH - _fontWidth + 1))) {
+		if (_wrap && (_cursorX > (_width - _fontWidth * _textSize + 1))) {
 			//Serial.print();
-			setCursor(0, _cursorY + _fontHeight + 1);
+			setCursor(0, _cursorY + (_fontHeight + 1) * _textSize);
 		}
 	}
 	return 1;
@@ -542,23 +1607,45 @@ byte SH1106Lib::write(uint8_t c)
 
 /*
 Draws a character on the screen from the font
+The parts that are outside of the clip rectangle are cut off. A character that is not in the font is not drawn
 x: x coordinate where the character should be displayed
 y: y coordinate where the character should be displayed
 character: The character to display
 color: the color of the character
 backgroundType: SOLID or TRANSPARENT
 */
-void SH1106Lib::drawChar(uint8_t x, uint8_t y, uint8_t character, uint8_t color, uint8_t backgroundType)
+void SH1106Lib::drawChar(int16_t x, int16_t y, uint8_t character, uint8_t color, uint8_t backgroundType)
 {
-	if ((x + _fontWidth >= SH1106_LCDWIDTH) || // Clip right
-		(y + _fontHeight >= SH1106_LCDHEIGHT) || // Clip bottom
-		((x + _fontWidth + 1) < 0) || // Clip left
-		((y + _fontHeight) < 0))   // Clip top
+	SH1106ClipArea area;
+	uint8_t byteHeight = intCeil(_fontHeight, 8) /*ceil(_fontHeight / 8.0)*/;
+	uint8_t page;
+	const byte *glyph = _font + (character - _fontOffset) * _fontWidth * byteHeight;
+	bool blank = character == ' ' && ((_fontFlags & FONT_HASSPACE) != FONT_HASSPACE);
+
+	if (!blank && (character - _fontOffset < 0 || character > _fontLast))
+	{ // it is not in the font, the data there belongs to something else
 		return;
+	}
 
-	uint8_t i, j, n;
-	uint8_t diff, yActual, actualByte;
-	uint8_t byteHeight = intCeil(_fontHeight, 8) /*ceil(_fontHeight / 8.0)*/;
+	if (!_clip(x, y, _fontWidth * _textSize, byteHeight * 8 * _textSize, area))
+	{ // nothing is visible
+		return;
+	}
+
+	if (1 < _textSize && (_rotation & 1))
+	{ // the scaled columns are transposed in 8x8 blocks, the same way as the bitmaps
+		_drawTransposed(x, y, glyph, byteHeight, 1, _fontWidth * _textSize, byteHeight * 8 * _textSize, color, backgroundType, blank, area, true);
+		return;
+	}
+
+	if (1 < _textSize)
+	{ // the columns are scaled up while they are drawn, a page at a time
+		for (page = area.top >> 3; page <= (area.bottom >> 3); page++)
+		{
+			_drawScaledPage(x, y, glyph, byteHeight, page, area.left, area.right - area.left + 1, _rowMask(area.top, area.bottom, page), color, backgroundType, blank);
+		}
+		return;
+	}
 
 	// try to mod the character, if the font does not have the required case
 	//if (isLowerCase(character))
@@ -576,49 +1663,298 @@ void SH1106Lib::drawChar(uint8_t x, uint8_t y, uint8_t character, uint8_t color,
 	//	}
 	//}
 
+	// the columns of the characters are stored like a bitmap, but column by column
+	_drawImage(x, y, glyph, byteHeight, 1, _fontWidth, byteHeight * 8, color, backgroundType, blank, area);
+}
+
+/*
+Measures how wide a text would be with the current font
+text: the text to measure, for multiple lines ('\n') the widest one counts
+
+returns: the width in pixels
+*/
+uint16_t SH1106Lib::measureText(const char *text)
+{
+	uint16_t widest = 0;
+	uint16_t length = 0;
 
-	// height / 8, because we will plot in columns with the height of 8
-	for (j = 0; j < byteHeight; j++) {
-		// calculate the start pos
-		diff = (y + j * 8) % 8;
-		for (n = 0; n < ((0 == diff) ? 1 : 2); n++) // if it starts on the page border, then we can do it in one run
+	for (;; text++)
+	{
+		if ('\0' == *text || '\n' == *text)
 		{
-			yActual = y + ((j + n) * 8);
-			if (yActual > SH1106_LCDHEIGHT)
-			{ // don't try to write outside the display area
-				continue;
+			if (length > widest)
+			{
+				widest = length;
 			}
-			_startRMWMode(x, y + ((j + n) * 8));
-			// loop through the width of the image, and plot the columns
-			for (i = 0; i < _fontWidth; i++) {
-				if ((x + i) > SH1106_LCDWIDTH)
-				{ // don't try to write outside the display area
-					continue;
-				}
-				if (i == _fontWidth || (character == ' ' && ((_fontFlags & FONT_HASSPACE) != FONT_HASSPACE))) {
-					actualByte = 0x00;
-				}
-				else {
-					actualByte = pgm_read_byte(_font + ((character - _fontOffset) * _fontWidth + i) * byteHeight + j);
-				}
-				if (0 == n)
-				{ // this is the below the page barrier
-					actualByte = actualByte << diff;
-				}
-				else
-				{ // this is the leftover - this only comes in play when the current part of the image crosses the page boundary
-					actualByte = actualByte >> (8 - diff);
+			if ('\0' == *text)
+			{
+				break;
+			}
+			length = 0;
+		}
+		else if ('\r' != *text)
+		{
+			length++;
+		}
+	}
+
+	// there is a one pixel gap between the characters, but not after the last one
+	return (0 == widest) ? 0 : widest * (_fontWidth + 1) * _textSize - _textSize;
+}
+
+/*
+Draws a text into a box, broken into lines at the word boundaries, with the current font and text color
+Words that are longer than a line are broken at the end of the line, and everything is clipped to the box.
+x: x coordinate of the top left corner of the box
+y: y coordinate of the top left corner of the box
+w: width of the box
+h: height of the box
+text: the text to draw ('\n' starts a new line)
+align: ALIGN_LEFT, ALIGN_CENTER or ALIGN_RIGHT
+layout: optional - where to keep the line breaks, so drawing the same text into the same box again skips the layout
+*/
+void SH1106Lib::drawTextBox(int16_t x, int16_t y, uint8_t w, uint8_t h, const char *text, uint8_t align/* = ALIGN_LEFT*/, SH1106TextLayout *layout/* = NULL*/)
+{
+	uint8_t line, length, k, lineWidth;
+	int16_t lineX, lineY;
+	uint8_t clipLeft = _clipLeft;
+	uint8_t clipTop = _clipTop;
+	uint8_t clipRight = _clipRight;
+	uint8_t clipBottom = _clipBottom;
+	uint16_t start = 0;
+	uint16_t next = 0;
+	uint8_t lineHeight = (_fontHeight + 1) * _textSize;
+	uint8_t advance = (_fontWidth + 1) * _textSize;
+	uint8_t capacity = (w + _textSize) / advance;
+	uint8_t maxLines = intCeil(h, lineHeight);
+	bool cached = (NULL != layout && layout->text == text && layout->width == w && layout->fontWidth == advance);
+
+	if (0 == capacity)
+	{ // nothing fits
+		return;
+	}
+
+	if (NULL != layout && !cached)
+	{ // start a new layout
+		layout->text = text;
+		layout->width = w;
+		layout->fontWidth = advance;
+		layout->lines = 0;
+		layout->next = 0;
+	}
+
+	// clip everything to the part of the box that is inside the current clip rectangle
+	_clipLeft = constrain(x + _originX, clipLeft, clipRight);
+	_clipTop = constrain(y + _originY, clipTop, clipBottom);
+	_clipRight = constrain(x + _originX + w, _clipLeft, clipRight);
+	_clipBottom = constrain(y + _originY + h, _clipTop, clipBottom);
+
+	for (line = 0; line < maxLines; line++)
+	{
+		lineY = y + line * lineHeight;
+		if (lineY + _originY >= _clipBottom)
+		{ // the rest is not visible
+			break;
+		}
+
+		if (cached && line < layout->lines)
+		{
+			start = layout->lineStart[line];
+			length = layout->lineLength[line];
+		}
+		else
+		{
+			if (cached && line == layout->lines)
+			{ // the rest of the text did not fit into the layout (or was not visible), go on from where it ended
+				next = layout->next;
+			}
+			if ('\0' == text[next])
+			{
+				break;
+			}
+			start = next;
+			next = _breakLine(text, start, capacity, length);
+			if (NULL != layout && line == layout->lines && line < SH1106_TEXTLAYOUT_LINES)
+			{
+				layout->lineStart[line] = start;
+				layout->lineLength[line] = length;
+				layout->lines = line + 1;
+				layout->next = next;
+			}
+		}
+
+		// position the line in the box
+		lineWidth = (0 == length) ? 0 : length * advance - _textSize;
+		lineX = x;
+		if (ALIGN_RIGHT == align)
+		{
+			lineX += w - lineWidth;
+		}
+		else if (ALIGN_CENTER == align)
+		{
+			lineX += (w - lineWidth) / 2;
+		}
+
+		for (k = 0; k < length; k++)
+		{
+			drawChar(lineX + k * advance, lineY, text[start + k], _textColor, _backgroundType);
+		}
+	}
+
+	// back to the previous clip rectangle
+	_clipLeft = clipLeft;
+	_clipTop = clipTop;
+	_clipRight = clipRight;
+	_clipBottom = clipBottom;
+}
+
+/*
+Reads back a part of the display memory
+Every page is read in a single I2C read transaction
+x: the x coordinate of the first column to read
+page: the first page (0..7) to read
+w: the number of columns to read
+pages: the number of pages to read
+buffer: the buffer to read into, it needs to be w * pages bytes. The data is stored page by page, in the same format as the bitmaps
+The part of the region that is not on the display (right of x = 127, or below page 7) is not read, those bytes of the buffer are left as they are
+*/
+void SH1106Lib::readRegion(uint8_t x, uint8_t page, uint8_t w, uint8_t pages, byte *buffer)
+{
+	uint8_t i, j;
+	uint8_t columns = _clipRegion(x, page, w, pages);
+
+	if (0 == columns)
+	{ // nothing to read
+		return;
+	}
+
+	for (j = page; j < page + pages; j++)
+	{
+		_beginTransmission(I2CWRITE, true);
+		// the reads move the column pointer, so always set the position explicitly
+		_pixelPosX = 0xFF;
+		_setDisplayWritePosition(x, j * SH1106_ROWHEIGHT);
+		_i2cWrite(0xC0); // the next bytes are data, otherwise the read returns the status register
+		_beginTransmission(I2CREAD, false); // restart in read mode
+		_i2cRead(false); // dummy read
+		for (i = 0; i < columns; i++)
+		{
+			buffer[i] = _i2cRead(i == columns - 1);
+		}
+		_endTransmission();
+		buffer += w;
+	}
+	// the column pointer is somewhere else than where it was set to
+	_pixelPosX = 0xFF;
+}
+
+/*
+Writes a part of the display memory, e.g. to restore what readRegion() saved from under a popup
+Every page is sent in a single write-only burst, without reading back the display
+x: the x coordinate of the first column to write
+page: the first page (0..7) to write
+w: the number of columns to write
+pages: the number of pages to write
+buffer: the data to write, w * pages bytes in the format readRegion() reads (it is in the RAM, not in the program memory)
+The part of the region that is not on the display (right of x = 127, or below page 7) is left out
+*/
+void SH1106Lib::writeRegion(uint8_t x, uint8_t page, uint8_t w, uint8_t pages, const byte *buffer)
+{
+	uint8_t i, j;
+	uint8_t columns = _clipRegion(x, page, w, pages);
+
+	if (0 == columns)
+	{ // nothing to write
+		return;
+	}
+
+	for (j = page; j < page + pages; j++)
+	{
+		beginPageWrite(x, j);
+		for (i = 0; i < columns; i++)
+		{
+			writePageData(buffer[i]);
+		}
+		endPageWrite();
+		buffer += w;
+	}
+}
+
+uint8_t SH1106Lib::_clipRegion(uint8_t x, uint8_t page, uint8_t w, uint8_t &pages)
+{
+	if (x >= SH1106_LCDWIDTH || page >= SH1106_NUMBEROF_PAGES)
+	{
+		return 0;
+	}
+	if (pages > SH1106_NUMBEROF_PAGES - page)
+	{
+		pages = SH1106_NUMBEROF_PAGES - page;
+	}
+	return (w > SH1106_LCDWIDTH - x) ? SH1106_LCDWIDTH - x : w;
+}
+
+/*
+Prints the whole display memory as a binary PBM (P4) image, for screenshots
+All 132 columns are included, so the 2 columns on both sides, that are not visible, are there too.
+The lit pixels are white in the image. The memory is read a page at a time in a single transaction,
+so it needs 132 bytes of stack instead of a framebuffer.
+out: where to print the image
+*/
+void SH1106Lib::printScreenshot(TinyPrint &out)
+{
+	uint8_t i, j, k, row, bits;
+	byte page[SH1106_NUMBEROF_SEGMENTS + 4];
+
+	out.print("P4\n132 64\n");
+
+	for (j = 0; j < SH1106_NUMBEROF_PAGES; j++)
+	{
+		// read the page from its very first column
+		_beginTransmission(I2CWRITE, true);
+		sendCommand(SH1106_PAGEADDR + j);
+		sendCommand(SH1106_SETCOLUMNADDRLOW);
+		sendCommand(SH1106_SETCOLUMNADDRHIGH);
+		_i2cWrite(0xC0); // the next bytes are data, otherwise the read returns the status register
+		_beginTransmission(I2CREAD, false); // restart in read mode
+		_i2cRead(false); // dummy read
+		for (i = 0; i < sizeof(page); i++)
+		{
+			page[i] = _i2cRead(i == sizeof(page) - 1);
+		}
+		_endTransmission();
+
+		// a PBM row has 8 pixels in a byte, the first one in the most significant bit, and 1 is black
+		for (row = 0; row < SH1106_ROWHEIGHT; row++)
+		{
+			for (i = 0; i < sizeof(page); i += 8)
+			{
+				bits = 0x00;
+				for (k = 0; k < 8; k++)
+				{
+					bits <<= 1;
+					if (i + k < sizeof(page) && 0 == (page[i + k] & (1 << row)))
+					{
+						bits |= 1;
+					}
 				}
-				// display the column of pixels
-				_drawColumn(actualByte, color, backgroundType, B11111111);
+				out.write(bits);
 			}
-			_stopRMWMode();
 		}
 	}
 
+	// the column pointer is somewhere else than where it was set to
+	_pixelPosX = 0xFF;
 }
 
 
+void SH1106Lib::_sendCommandArgument(byte command, byte argument)
+{
+	_beginTransmission(I2CWRITE, true);
+	sendCommand(command);
+	sendCommand(argument);
+	_endTransmission();
+}
+
 /*
 Draws a character on the screen from the font
 x: the x coordinate
@@ -647,6 +1983,11 @@ void SH1106Lib::_setDisplayWritePosition(uint8_t x, uint8_t y)
 
 void SH1106Lib::_beginTransmission(byte operation/* = I2CWRITE*/, bool startNewTransmission/* = false*/)
 {
+	if (NULL != _batch && (startNewTransmission || !_i2cTransmissionInProgress))
+	{ // the collected columns have to be on the display, before anything else is sent
+		_flushBatch();
+	}
+
 	if (_i2cTransmissionInProgress && !startNewTransmission)
 	{ // send a repeated start if there is no need to start a new one
 		if (!i2c_rep_start((SH1106_I2C_ADDRESS << 1) | operation))
@@ -669,26 +2010,61 @@ void SH1106Lib::_beginTransmission(byte operation/* = I2CWRITE*/, bool startNewT
 	}
 
 	_i2cTransmissionInProgress = true;
+#if SH1106_BUSSTATS
+	_busStats.starts++;
+	_busStats.bytesWritten++; // the address byte
+#endif
 }
 
 void SH1106Lib::_endTransmission()
 {
 	i2c_stop();
 	_i2cTransmissionInProgress = false;
+#if SH1106_BUSSTATS
+	_busStats.stops++;
+#endif
+}
+
+void SH1106Lib::_i2cWrite(byte data)
+{
+	i2c_write(data);
+#if SH1106_BUSSTATS
+	_busStats.bytesWritten++;
+#endif
+}
+
+byte SH1106Lib::_i2cRead(bool last)
+{
+#if SH1106_BUSSTATS
+	_busStats.bytesRead++;
+#endif
+	return i2c_read(last);
 }
 
 void SH1106Lib::_startRMWMode(uint8_t x, uint8_t y)
 {
+	if (NULL != _batch)
+	{ // the columns go into the batch
+		_batch->cursor = x;
+		_batch->cursorPage = y >> 3;
+		return;
+	}
+
 	_beginTransmission(I2CWRITE, true);
 
 	// set the position and enable the readmodifywrite mode
 	_setDisplayWritePosition(x, y);
 	sendCommand(SH1106_READMODIFYWRITE_START);
-	i2c_write(0xC0); // ???? 
+	_i2cWrite(0xC0); // ???? 
 }
 
 void SH1106Lib::_stopRMWMode()
 {
+	if (NULL != _batch)
+	{ // there is no session to end
+		return;
+	}
+
 	// end the readmodifywrite mode
 	sendCommand(SH1106_READMODIFYWRITE_END);
 	_endTransmission();
@@ -696,41 +2072,159 @@ void SH1106Lib::_stopRMWMode()
 
 void SH1106Lib::_drawColumn(uint8_t data, uint8_t color, uint8_t backgroundType/* = TRANSPARENT*/, byte backgroundMask/* = B00000000*/)
 {
-	byte b = data;
-	// read the pixel data from the display
-	_beginTransmission(I2CREAD, false); // restart in read mode
-	i2c_read(false); // dummy read
-	b = i2c_read(true);
+	byte andMask = 0xFF;
+	byte xorMask = 0x00;
 
-	// handle the solid/transparent background
-	if (SOLID == backgroundType)
+	// handle the solid/transparent background (the inverse drawing has to be undone by drawing it again, so it never has one)
+	if (SOLID == backgroundType && INVERSE != color)
 	{
+		andMask = ~backgroundMask;
 		if (BLACK == color)
 		{ // solid white background
-			b |= backgroundMask;
-		}
-		else
-		{ // solid black background
-			b &= ~backgroundMask;
+			xorMask = backgroundMask;
 		}
 	}
 
-	// modify the read byte with the data, based on the color
+	// modify the pixels with the data, based on the color
 	if (WHITE == color)
 	{
-		b |= data;
+		andMask &= ~data;
+		xorMask = (xorMask & ~data) | data;
+	}
+	else if (INVERSE == color)
+	{
+		xorMask ^= data;
 	}
 	else
 	{
-		b &= ~data;
+		andMask &= ~data;
+		xorMask &= ~data;
+	}
+
+	_modifyColumn(andMask, xorMask);
+}
+
+void SH1106Lib::_modifyColumn(byte andMask, byte xorMask)
+{
+	byte b;
+
+	if (NULL != _batch)
+	{
+		_batchColumn(andMask, xorMask);
+		return;
 	}
 
+	// read the pixel data from the display
+	_beginTransmission(I2CREAD, false); // restart in read mode
+	_i2cRead(false); // dummy read
+	b = _i2cRead(true);
+
 	// write the modified data back
-	sendData(b);
+	sendData((b & andMask) ^ xorMask);
+}
+
+void SH1106Lib::_batchColumn(byte andMask, byte xorMask)
+{
+	SH1106ColumnBatch &batch = *_batch;
+	uint8_t column = batch.cursor++;
+	uint8_t i;
+
+	// the run on the same page, or an empty one, or the one that was not used the last time
+	i = batch.last;
+	if (0 == batch.runs[i].count || batch.runs[i].page != batch.cursorPage)
+	{ // not the run of this page
+		if ((0 != batch.runs[i ^ 1].count && batch.runs[i ^ 1].page == batch.cursorPage) || 0 != batch.runs[i].count)
+		{ // the other one is on this page, or this one has to be kept
+			i ^= 1;
+		}
+	}
+	batch.last = i;
+	SH1106ColumnRun &run = batch.runs[i];
+
+	// reading and writing back two untouched columns is still cheaper, than starting a new session
+	if (0 != run.count
+		&& (run.page != batch.cursorPage
+			|| column < run.x
+			|| column > run.x + run.count + 2
+			|| column >= run.x + SH1106_MAXSEGMENTSPERWRITE))
+	{
+		_flushRun(run);
+	}
+	if (0 == run.count)
+	{
+		run.x = column;
+		run.page = batch.cursorPage;
+	}
+
+	i = column - run.x;
+	// the untouched columns before it are written back as they are
+	while (run.count <= i)
+	{
+		run.andMask[run.count] = 0xFF;
+		run.xorMask[run.count] = 0x00;
+		run.count++;
+	}
+	// the column is modified after what was folded into it before
+	run.xorMask[i] = (run.xorMask[i] & andMask) ^ xorMask;
+	run.andMask[i] &= andMask;
+}
+
+void SH1106Lib::_flushRun(SH1106ColumnRun &run)
+{
+	SH1106ColumnBatch *batch = _batch;
+
+	// the session has to go to the display, not into the batch
+	_batch = NULL;
+	_startRMWMode(run.x, run.page * SH1106_ROWHEIGHT);
+	for (uint8_t i = 0; i < run.count; i++)
+	{
+		_modifyColumn(run.andMask[i], run.xorMask[i]);
+	}
+	_stopRMWMode();
+	run.count = 0;
+	_batch = batch;
+}
+
+void SH1106Lib::_flushBatch()
+{
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		if (0 != _batch->runs[i].count)
+		{
+			_flushRun(_batch->runs[i]);
+		}
+	}
 }
 
 void SH1106Lib::_drawColumns(uint8_t x, uint8_t y, uint8_t data, uint8_t count, uint8_t color)
 {
+#if SH1106_COMPOSE_BUFFER
+	uint32_t buffer[(SH1106_COMPOSE_BUFFER + 3) / 4];
+	byte *columns = (byte *)buffer;
+	uint8_t n;
+
+	// a single column (a pixel) is cheaper in the ReadModifyWrite mode, than with two transmissions
+	if (count > 1 || (0xFF == data && INVERSE != color))
+	{
+		while (0 != count)
+		{
+			n = (count > SH1106_COMPOSE_BUFFER) ? SH1106_COMPOSE_BUFFER : count;
+			if (0xFF == data && INVERSE != color)
+			{ // the whole column is overwritten, no need to read it
+				memset(columns, (BLACK == color) ? 0x00 : 0xFF, n);
+			}
+			else
+			{
+				readRegion(x, y >> 3, n, 1, columns);
+				_composeFill(columns, n, data, color);
+			}
+			writeRegion(x, y >> 3, n, 1, columns);
+			x += n;
+			count -= n;
+		}
+		return;
+	}
+#endif
 	_startRMWMode(x, y);
 	for (uint8_t i = 0; i < count; i++)
 	{
@@ -739,6 +2233,1480 @@ void SH1106Lib::_drawColumns(uint8_t x, uint8_t y, uint8_t data, uint8_t count,
 	_stopRMWMode();
 }
 
+/*
+Draws the tiles of the map that have changed since the last render
+The neighbouring changed tiles in a row are sent in a single write-only burst, without reading back the display
+map: the tile map to draw
+*/
+void SH1106Lib::renderTiles(SH1106TileMap &map)
+{
+	uint8_t row, column, k;
+	const byte *tile;
+
+	for (row = 0; row < SH1106_TILEMAP_ROWS; row++)
+	{
+		column = 0;
+		while (0 != map._dirty[row])
+		{
+			if (0 == (map._dirty[row] & (1U << column)))
+			{ // not changed, look at the next one
+				column++;
+				continue;
+			}
+
+			// send the run of changed tiles
+			beginPageWrite(column * SH1106_TILE_SIZE, row);
+			do
+			{
+				tile = map._tileset + map._tiles[row][column] * SH1106_TILE_SIZE;
+				for (k = 0; k < SH1106_TILE_SIZE; k++)
+				{
+					writePageData(pgm_read_byte(tile + k));
+				}
+				map._dirty[row] &= ~(1U << column);
+				column++;
+			} while (column < SH1106_TILEMAP_COLUMNS && 0 != (map._dirty[row] & (1U << column)));
+			endPageWrite();
+		}
+	}
+}
+
+/*
+Starts writing data directly to a page of the display, without reading it back
+Every writePageData() call after this outputs one column, moving to the right, until endPageWrite() is called
+x: the x coordinate of the first column
+page: the page 0..7
+*/
+void SH1106Lib::beginPageWrite(uint8_t x, uint8_t page)
+{
+	_beginTransmission(I2CWRITE, true);
+	_setDisplayWritePosition(x, page * SH1106_ROWHEIGHT);
+	// a single control byte, that says everything until the end of the transmission is data
+	_beginTransmission(I2CWRITE, false);
+	_i2cWrite(SH1106_MESSAGETYPE_DATA);
+}
+
+/*
+Outputs one column of pixels, after beginPageWrite()
+data: the 8 pixels of the column (the least significant bit is the top one)
+*/
+void SH1106Lib::writePageData(byte data)
+{
+	_i2cWrite(data);
+	// every write advances the column pointer
+	_pixelPosX++;
+}
+
+/*
+Finishes writing data that was started with beginPageWrite()
+*/
+void SH1106Lib::endPageWrite()
+{
+	_endTransmission();
+}
+
+/*
+Draws the commands waiting in the queue
+The ReadModifyWrite columns of the commands are collected, and the ones that fall onto the same page (on the
+display, after the rotation) close to each other are drawn together in a single ReadModifyWrite session,
+whatever the command is (pixel, rectangle, bitmap or character)
+queue: the queue to empty
+*/
+void SH1106Lib::drainCommands(SH1106CommandQueue &queue)
+{
+	SH1106Command command;
+	SH1106ColumnBatch batch;
+
+	batch.last = 0;
+	batch.runs[0].count = batch.runs[1].count = 0;
+	_batch = &batch;
+
+	while (queue.peek(command))
+	{
+		queue.pop();
+		switch (command.type)
+		{
+		case SH1106_CMD_PIXEL:
+			drawPixel(command.x, command.y, command.color);
+			break;
+		case SH1106_CMD_FILLRECT:
+			fillRect(command.x, command.y, command.w, command.h, command.color);
+			break;
+		case SH1106_CMD_BITMAP:
+			drawBitmap(command.x, command.y, command.bitmap, command.w, command.h, command.color, command.backgroundType);
+			break;
+		case SH1106_CMD_CHAR:
+			drawChar(command.x, command.y, command.w, command.color, command.backgroundType);
+			break;
+		}
+	}
+
+	_flushBatch();
+	_batch = NULL;
+}
+
+uint16_t SH1106Lib::_breakLine(const char *text, uint16_t start, uint8_t capacity, uint8_t &length)
+{
+	uint16_t i;
+	uint16_t lastSpace = 0xFFFF;
+
+	// go as far as the line can hold
+	for (i = start; '\0' != text[i] && '\n' != text[i] && (i - start) < capacity; i++)
+	{
+		if (' ' == text[i])
+		{
+			lastSpace = i;
+		}
+	}
+
+	if ('\0' == text[i] || '\n' == text[i])
+	{ // the rest of the line fits
+		length = i - start;
+		return ('\n' == text[i]) ? i + 1 : i;
+	}
+
+	if (' ' == text[i])
+	{ // the line is full, and a word ends exactly at the end
+		length = i - start;
+	}
+	else if (0xFFFF != lastSpace)
+	{ // break at the last space
+		length = lastSpace - start;
+		i = lastSpace;
+	}
+	else
+	{ // a word that is longer than the line, break it at the end of the line
+		length = capacity;
+	}
+
+	// the spaces at the break are not drawn
+	while (length > 0 && ' ' == text[start + length - 1])
+	{
+		length--;
+	}
+	while (' ' == text[i])
+	{
+		i++;
+	}
+
+	return i;
+}
+
+void SH1106Lib::_fillArea(uint8_t left, uint8_t width, uint8_t top, uint8_t bottom, uint8_t color)
+{
+	// the first and the last page only get the rows that are covered, the inner ones are filled completely
+	for (uint8_t page = top >> 3; page <= (bottom >> 3); page++)
+	{
+		_drawColumns(left, page * SH1106_ROWHEIGHT, _rowMask(top, bottom, page), width, color);
+	}
+}
+
+#if SH1106_COMPOSE_BUFFER
+void SH1106Lib::_composeFill(byte *columns, uint8_t count, byte data, uint8_t color)
+{
+	uint8_t i = 0;
+
+#if SH1106_WORD_KERNELS
+	// 4 columns at once, the buffer is aligned, so only the tail is left for the byte loop
+	uint32_t *words = (uint32_t *)columns;
+	uint32_t wordData = data * 0x01010101UL;
+
+	for (; i + 4 <= count; i += 4, words++)
+	{
+		if (WHITE == color)
+		{
+			*words |= wordData;
+		}
+		else if (INVERSE == color)
+		{
+			*words ^= wordData;
+		}
+		else
+		{
+			*words &= ~wordData;
+		}
+	}
+#endif
+	for (; i < count; i++)
+	{
+		if (WHITE == color)
+		{
+			columns[i] |= data;
+		}
+		else if (INVERSE == color)
+		{
+			columns[i] ^= data;
+		}
+		else
+		{
+			columns[i] &= ~data;
+		}
+	}
+}
+
+void SH1106Lib::_composeImage(byte *columns, const byte *lower, const byte *upper, uint8_t columnStride, uint8_t shift, uint8_t count, byte mask, uint8_t color, uint8_t backgroundType)
+{
+	uint8_t i = 0;
+	byte b, actualByte;
+	// the inverse drawing has to be undone by drawing it again, so it never has a background
+	bool solid = SOLID == backgroundType && INVERSE != color;
+
+#if SH1106_WORD_KERNELS
+	if (1 == columnStride)
+	{ // 4 columns at once: the shifts are done on the whole word, and the bits that cross into the neighbouring byte are masked off
+		uint32_t *words = (uint32_t *)columns;
+		uint32_t wordMask = mask * 0x01010101UL;
+		uint32_t lowerMask = (byte)(0xFF << shift) * 0x01010101UL;
+		uint32_t source, word;
+
+		for (; i + 4 <= count; i += 4, words++)
+		{
+			word = 0;
+			if (NULL != lower)
+			{ // the bitmap can be at any address, so it is copied out, instead of read as a word
+				memcpy_P(&source, lower + i, 4);
+				word = (source << shift) & lowerMask;
+			}
+			if (NULL != upper)
+			{
+				memcpy_P(&source, upper + i, 4);
+				word |= (source >> (8 - shift)) & ~lowerMask;
+			}
+			word &= wordMask;
+
+			if (solid)
+			{
+				*words = (BLACK == color) ? (*words | wordMask) : (*words & ~wordMask);
+			}
+			if (WHITE == color)
+			{
+				*words |= word;
+			}
+			else if (INVERSE == color)
+			{
+				*words ^= word;
+			}
+			else
+			{
+				*words &= ~word;
+			}
+		}
+	}
+#endif
+	for (; i < count; i++)
+	{
+		actualByte = 0x00;
+		if (NULL != lower)
+		{
+			actualByte = pgm_read_byte(lower + i * columnStride) << shift;
+		}
+		if (NULL != upper)
+		{
+			actualByte |= pgm_read_byte(upper + i * columnStride) >> (8 - shift);
+		}
+		actualByte &= mask;
+
+		b = columns[i];
+		if (solid)
+		{
+			b = (BLACK == color) ? (b | mask) : (b & ~mask);
+		}
+		if (WHITE == color)
+		{
+			b |= actualByte;
+		}
+		else if (INVERSE == color)
+		{
+			b ^= actualByte;
+		}
+		else
+		{
+			b &= ~actualByte;
+		}
+		columns[i] = b;
+	}
+}
+
+bool SH1106Lib::_composeCovers(const byte *lower, const byte *upper, uint8_t columnStride, uint8_t shift, uint8_t count)
+{
+	byte actualByte;
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		actualByte = 0x00;
+		if (NULL != lower)
+		{
+			actualByte = pgm_read_byte(lower + i * columnStride) << shift;
+		}
+		if (NULL != upper)
+		{
+			actualByte |= pgm_read_byte(upper + i * columnStride) >> (8 - shift);
+		}
+		if (0xFF != actualByte)
+		{ // the old pixel shows through the hole
+			return false;
+		}
+	}
+	return true;
+}
+#endif
+
+void SH1106Lib::_drawShaded(int16_t x, int16_t y, uint8_t w, const SH1106ClipArea &area, const byte *columns, const byte *bitmap)
+{
+	uint8_t left, right, top, bottom, page, i;
+	byte mask, data;
+
+	if (_rotation & 1)
+	{ // the rows of the rectangle are columns on the display
+		left = SH1106_LCDWIDTH - 1 - area.bottom;
+		right = SH1106_LCDWIDTH - 1 - area.top;
+		top = area.left;
+		bottom = area.right;
+	}
+	else
+	{
+		left = area.left;
+		right = area.right;
+		top = area.top;
+		bottom = area.bottom;
+	}
+
+	for (page = top >> 3; page <= (bottom >> 3); page++)
+	{
+		mask = _rowMask(top, bottom, page);
+		if (0xFF == mask)
+		{ // the whole page is overwritten, no need to read it
+			beginPageWrite(left, page);
+		}
+		else
+		{
+			_startRMWMode(left, page * SH1106_ROWHEIGHT);
+		}
+
+		for (i = left; i <= right; i++)
+		{
+			data = (NULL != columns) ? columns[i & 7] : _ditherColumn(x, y, w, bitmap, i, page, mask);
+			if (0xFF == mask)
+			{
+				writePageData(data);
+			}
+			else
+			{ // the solid background clears the covered rows, before the lit pixels are drawn
+				_drawColumn(data & mask, WHITE, SOLID, mask);
+			}
+		}
+
+		if (0xFF == mask)
+		{
+			endPageWrite();
+		}
+		else
+		{
+			_stopRMWMode();
+		}
+	}
+}
+
+byte SH1106Lib::_ditherColumn(int16_t x, int16_t y, uint8_t w, const byte *bitmap, uint8_t displayX, uint8_t page, byte mask)
+{
+	uint8_t k, screenX, screenY;
+	byte data = 0x00;
+
+	for (k = 0; k < 8; k++)
+	{
+		if (0 == (mask & (1 << k)))
+		{ // not part of the bitmap
+			continue;
+		}
+
+		if (_rotation & 1)
+		{
+			screenX = page * SH1106_ROWHEIGHT + k;
+			screenY = SH1106_LCDWIDTH - 1 - displayX;
+		}
+		else
+		{
+			screenX = displayX;
+			screenY = page * SH1106_ROWHEIGHT + k;
+		}
+
+		// 0..255 is scaled to the 0..64 levels of the dither
+		if (pgm_read_byte(&SH1106_BAYER[screenY & 7][screenX & 7]) < ((pgm_read_byte(bitmap + (uint16_t)(screenY - y) * w + (screenX - x)) * (SH1106_DITHER_LEVELS + 1)) >> 8))
+		{
+			data |= 1 << k;
+		}
+	}
+
+	return data;
+}
+
+bool SH1106Lib::_clip(int16_t &x, int16_t &y, uint8_t w, uint8_t h, SH1106ClipArea &area)
+{
+	int16_t left, top, right, bottom;
+
+	// move it by the origin
+	x += _originX;
+	y += _originY;
+
+	// cut it to the clip rectangle
+	left = (x < _clipLeft) ? _clipLeft : x;
+	top = (y < _clipTop) ? _clipTop : y;
+	right = (x + w > _clipRight) ? _clipRight - 1 : x + w - 1;
+	bottom = (y + h > _clipBottom) ? _clipBottom - 1 : y + h - 1;
+
+	if (left > right || top > bottom)
+	{ // nothing is left of it
+		return false;
+	}
+
+	area.left = left;
+	area.top = top;
+	area.right = right;
+	area.bottom = bottom;
+
+	return true;
+}
+
+bool SH1106Lib::_toDisplay(int16_t x, int16_t y, uint8_t &displayX, uint8_t &displayY)
+{
+	SH1106ClipArea area;
+
+	if (!_clip(x, y, 1, 1, area))
+	{
+		return false;
+	}
+
+	if (_rotation & 1)
+	{ // the screen y goes from the right to the left on the display, the x from the top to the bottom
+		displayX = SH1106_LCDWIDTH - 1 - area.top;
+		displayY = area.left;
+	}
+	else
+	{
+		displayX = area.left;
+		displayY = area.top;
+	}
+
+	return true;
+}
+
+void SH1106Lib::_drawImage(int16_t x, int16_t y, const byte *data, uint8_t columnStride, uint8_t pageStride, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType, bool blank, const SH1106ClipArea &area)
+{
+	if (_rotation & 1)
+	{
+		_drawTransposed(x, y, data, columnStride, pageStride, w, h, color, backgroundType, blank, area);
+		return;
+	}
+
+	// one ReadModifyWrite session for every page of the display that the visible part covers
+	for (uint8_t page = area.top >> 3; page <= (area.bottom >> 3); page++)
+	{
+		_drawImagePage(x, y, data, columnStride, pageStride, intCeil(h, 8), page, area.left, area.right - area.left + 1, _rowMask(area.top, area.bottom, page), color, backgroundType, blank);
+	}
+}
+
+void SH1106Lib::_drawImagePage(int16_t x, int16_t y, const byte *data, uint8_t columnStride, uint8_t pageStride, uint8_t pages, uint8_t page, uint8_t left, uint8_t count, byte mask, uint8_t color, uint8_t backgroundType, bool blank)
+{
+	uint8_t shift = y & 7;
+	// the page of the bitmap that starts on this page of the display (the one before it hangs into it from above)
+	int16_t j = page - (y - shift) / 8;
+	bool hasLower = !blank && j >= 0 && j < pages;
+	bool hasUpper = !blank && 0 != shift && j >= 1 && j <= pages;
+	const byte *column = data + (left - x) * columnStride;
+
+#if SH1106_COMPOSE_BUFFER
+	uint32_t buffer[(SH1106_COMPOSE_BUFFER + 3) / 4];
+	byte *columns = (byte *)buffer;
+	uint8_t n;
+	// the whole columns are drawn over, so none of the old pixels can remain
+	bool covers = (0xFF == mask && INVERSE != color);
+
+	while (0 != count)
+	{
+		n = (count > SH1106_COMPOSE_BUFFER) ? SH1106_COMPOSE_BUFFER : count;
+		// a solid background, or a transparent image without a clear bit in it, does not need the old columns
+		if (!covers || (SOLID != backgroundType && (blank || !_composeCovers(hasLower ? column + j * pageStride : NULL, hasUpper ? column + (j - 1) * pageStride : NULL, columnStride, shift, n))))
+		{
+			readRegion(left, page, n, 1, columns);
+		}
+		_composeImage(columns, hasLower ? column + j * pageStride : NULL, hasUpper ? column + (j - 1) * pageStride : NULL, columnStride, shift, n, mask, color, backgroundType);
+		writeRegion(left, page, n, 1, columns);
+		left += n;
+		count -= n;
+		column += n * columnStride;
+	}
+#else
+	uint8_t i, actualByte;
+
+	_startRMWMode(left, page * SH1106_ROWHEIGHT);
+	// loop through the visible columns of the image, and plot them
+	for (i = 0; i < count; i++, column += columnStride)
+	{
+		actualByte = 0x00;
+		if (hasLower)
+		{ // the part below the page barrier
+			actualByte = pgm_read_byte(column + j * pageStride) << shift;
+		}
+		if (hasUpper)
+		{ // the leftover of the page above, that crosses the page boundary
+			actualByte |= pgm_read_byte(column + (j - 1) * pageStride) >> (8 - shift);
+		}
+		// display the column of pixels
+		_drawColumn(actualByte & mask, color, backgroundType, mask);
+	}
+	_stopRMWMode();
+#endif
+}
+
+void SH1106Lib::_drawTransposed(int16_t x, int16_t y, const byte *data, uint8_t columnStride, uint8_t pageStride, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType, bool blank, const SH1106ClipArea &area, bool scaled/* = false*/)
+{
+	uint8_t j, k, n, r, shift, mask, firstRow, lastRow, actualByte, actualMask;
+	uint16_t i;
+	int16_t row, column;
+	byte block[8];
+
+	for (j = 0; j < intCeil(h, 8); j++)
+	{
+		row = y + j * 8;
+		if (row > area.bottom)
+		{ // the rest is below the visible part
+			break;
+		}
+		if (row + 7 < area.top)
+		{ // above the visible part
+			continue;
+		}
+		// the rows of this page of the bitmap that are visible
+		firstRow = (row < area.top) ? area.top - row : 0;
+		lastRow = (row + 7 > area.bottom) ? area.bottom - row : 7;
+
+		for (i = 0; i < w; i += 8)
+		{
+			column = x + i;
+			if (column > area.right)
+			{ // the rest is right of the visible part
+				break;
+			}
+			if (column + 7 < area.left)
+			{ // left of the visible part
+				continue;
+			}
+
+			// collect 8 columns of the bitmap, and the mask of the visible ones
+			mask = 0x00;
+			for (k = 0; k < 8; k++)
+			{
+				block[k] = 0x00;
+				if (column + k >= area.left && column + k <= area.right)
+				{
+					mask |= 1 << k;
+					if (scaled && !blank)
+					{ // every column of the font is repeated _textSize times
+						block[k] = _scaledByte(data + (i + k) / _textSize * columnStride, j);
+					}
+					else if (!blank)
+					{
+						block[k] = pgm_read_byte(data + (i + k) * columnStride + j * pageStride);
+					}
+				}
+			}
+			// the rows of the block become the columns of the display
+			_transpose8(block);
+
+			// the block is on one page, or crosses into the next one
+			shift = column & 7;
+			for (n = 0; n < ((0 == shift) ? 1 : 2); n++)
+			{
+				actualMask = (0 == n) ? mask << shift : mask >> (8 - shift);
+				if (0 == actualMask)
+				{ // nothing visible on this page
+					continue;
+				}
+				// the last row of the block is the leftmost column on the display
+				_startRMWMode(SH1106_LCDWIDTH - 1 - (row + lastRow), ((column - shift) / 8 + n) * SH1106_ROWHEIGHT);
+				for (r = lastRow + 1; r-- > firstRow;)
+				{
+					actualByte = (0 == n) ? block[r] << shift : block[r] >> (8 - shift);
+					_drawColumn(actualByte & actualMask, color, backgroundType, actualMask);
+				}
+				_stopRMWMode();
+			}
+		}
+	}
+}
+
+void SH1106Lib::_transpose8(byte *block)
+{
+	// Hacker's Delight 7-3: three rounds of swapping 1x1, 2x2 and 4x4 bit blocks, on two 32 bit words
+	uint32_t x = ((uint32_t)block[7] << 24) | ((uint32_t)block[6] << 16) | ((uint32_t)block[5] << 8) | block[4];
+	uint32_t y = ((uint32_t)block[3] << 24) | ((uint32_t)block[2] << 16) | ((uint32_t)block[1] << 8) | block[0];
+	uint32_t t;
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA; x = x ^ t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA; y = y ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+	t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+	y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+	x = t;
+
+	block[7] = x >> 24;
+	block[6] = x >> 16;
+	block[5] = x >> 8;
+	block[4] = x;
+	block[3] = y >> 24;
+	block[2] = y >> 16;
+	block[1] = y >> 8;
+	block[0] = y;
+}
+
+byte SH1106Lib::_scaledByte(const byte *column, uint8_t page)
+{
+	// every page of the font makes _textSize pages
+	byte b = pgm_read_byte(column + page / _textSize);
+	const uint16_t *spread = SH1106_SPREAD[_textSize - 2];
+	uint32_t bits = pgm_read_word(spread + (b & 0x0F)) | ((uint32_t)pgm_read_word(spread + (b >> 4)) << (4 * _textSize));
+
+	return bits >> (8 * (page % _textSize));
+}
+
+void SH1106Lib::_drawScaledPage(int16_t x, int16_t y, const byte *glyph, uint8_t byteHeight, uint8_t page, uint8_t left, uint8_t count, byte mask, uint8_t color, uint8_t backgroundType, bool blank)
+{
+	uint8_t i, c;
+	uint8_t actualByte = 0x00;
+	uint8_t shift = y & 7;
+	uint8_t pages = byteHeight * _textSize;
+	// the page of the character that starts on this page of the display (the one before it hangs into it from above)
+	int16_t j = page - (y - shift) / 8;
+	bool hasLower = !blank && j >= 0 && j < pages;
+	bool hasUpper = !blank && 0 != shift && j >= 1 && j <= pages;
+	uint8_t scaled = 0xFF;
+
+	_startRMWMode(left, page * SH1106_ROWHEIGHT);
+	for (i = 0; i < count; i++)
+	{
+		c = (left + i - x) / _textSize;
+		if (c != scaled)
+		{ // the next column of the font, the same byte is drawn _textSize times
+			scaled = c;
+			actualByte = 0x00;
+			if (hasLower)
+			{
+				actualByte = _scaledByte(glyph + c * byteHeight, j) << shift;
+			}
+			if (hasUpper)
+			{ // the leftover of the page above, that crosses the page boundary
+				actualByte |= _scaledByte(glyph + c * byteHeight, j - 1) >> (8 - shift);
+			}
+		}
+		_drawColumn(actualByte & mask, color, backgroundType, mask);
+	}
+	_stopRMWMode();
+}
+
+byte SH1106Lib::_reverseBits(byte b)
+{
+	b = (b >> 4) | (b << 4);
+	b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+	b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+
+	return b;
+}
+
+void SH1106Lib::_readRowMajorBlock(const byte *bitmap, uint8_t stride, uint8_t h, int16_t page, uint8_t column, byte *block)
+{
+	int16_t row;
+
+	for (uint8_t r = 0; r < 8; r++)
+	{
+		row = page * 8 + r;
+		block[r] = (row >= 0 && row < h) ? pgm_read_byte(bitmap + row * stride + column) : 0x00;
+	}
+	// bit k of row r becomes bit r of block[k], and the bit 7 is the leftmost pixel
+	_transpose8(block);
+}
+
+void SH1106Lib::_drawRowMajorPage(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t page, uint8_t left, uint8_t count, byte mask, uint8_t color, uint8_t backgroundType)
+{
+	uint8_t i, c, actualByte;
+	uint8_t stride = intCeil(w, 8);
+	uint8_t shift = y & 7;
+	// the page of the bitmap that starts on this page of the display (the one before it hangs into it from above)
+	int16_t j = page - (y - shift) / 8;
+	uint8_t loaded = 0xFF;
+	byte lower[8];
+	byte upper[8];
+
+	_startRMWMode(left, page * SH1106_ROWHEIGHT);
+	for (i = 0; i < count; i++)
+	{
+		c = left + i - x;
+		if ((c >> 3) != loaded)
+		{ // entered the next 8 columns of the bitmap
+			loaded = c >> 3;
+			_readRowMajorBlock(bitmap, stride, h, j, loaded, lower);
+			if (0 != shift)
+			{
+				_readRowMajorBlock(bitmap, stride, h, j - 1, loaded, upper);
+			}
+		}
+
+		actualByte = lower[7 - (c & 7)] << shift;
+		if (0 != shift)
+		{ // the leftover of the page above, that crosses the page boundary
+			actualByte |= upper[7 - (c & 7)] >> (8 - shift);
+		}
+		_drawColumn(actualByte & mask, color, backgroundType, mask);
+	}
+	_stopRMWMode();
+}
+
+void SH1106Lib::_drawRowMajorRows(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t page, const SH1106ClipArea &area, uint8_t color, uint8_t backgroundType)
+{
+	uint8_t stride = intCeil(w, 8);
+	byte mask = _rowMask(area.left, area.right, page);
+	// the bitmap column on the top row of the page
+	int16_t c = page * SH1106_ROWHEIGHT - x;
+	uint8_t shift = c & 7;
+	int16_t i = c >> 3;
+	int16_t row;
+	const byte *data;
+	uint16_t bits;
+
+	// the bottom row of the bitmap is the leftmost column on the display
+	_startRMWMode(SH1106_LCDWIDTH - 1 - area.bottom, page * SH1106_ROWHEIGHT);
+	for (row = area.bottom; row >= area.top; row--)
+	{
+		data = bitmap + (row - y) * stride;
+		// the 16 pixels of the two bytes that the page covers, the leftmost is the most significant bit
+		bits = 0;
+		if (i >= 0 && i < stride)
+		{
+			bits = pgm_read_byte(data + i) << 8;
+		}
+		if (i + 1 >= 0 && i + 1 < stride)
+		{
+			bits |= pgm_read_byte(data + i + 1);
+		}
+		// the leftmost pixel of the page goes to the top
+		_drawColumn(_reverseBits((bits << shift) >> 8) & mask, color, backgroundType, mask);
+	}
+	_stopRMWMode();
+}
+
+void SH1106Lib::_clearColumns(uint8_t x, uint8_t page, uint8_t count)
+{
+	_beginTransmission(I2CWRITE, true);
+	_setDisplayWritePosition(x, page * SH1106_ROWHEIGHT);
+	// no need to set the draw position, as every memory write advances the write pos to the next one
+	for (uint8_t i = 0; i < count; i++)
+	{
+		sendData(0x00);
+	}
+	// keep track of where the writes moved the column pointer
+	_pixelPosX = x + count;
+	_endTransmission();
+}
+
+byte SH1106Lib::_rowMask(uint8_t top, uint8_t bottom, uint8_t page)
+{
+	byte mask = B11111111;
+
+	if (page == (top >> 3))
+	{ // cut off the rows above the top
+		mask &= B11111111 << (top & 7);
+	}
+	if (page == (bottom >> 3))
+	{ // cut off the rows below the bottom
+		mask &= B11111111 >> (7 - (bottom & 7));
+	}
+
+	return mask;
+}
+
+#if SH1106_INCREMENTAL
+/*
+Queues clearing the display, it will be done step by step by service()
+
+returns: false if the queue is full
+*/
+bool SH1106Lib::queueClearDisplay()
+{
+	SH1106ClipArea area = { 0, 0, SH1106_NUMBEROF_SEGMENTS - 1, SH1106_LCDHEIGHT - 1 };
+
+	return _queueJob(SH1106_JOB_CLEAR, 0, 0, SH1106_NUMBEROF_SEGMENTS, SH1106_LCDHEIGHT, area, BLACK, TRANSPARENT, NULL);
+}
+
+/*
+Queues a filled rectangle, it will be drawn step by step by service()
+It is clipped (and moved by the origin) when it is queued, just like fillRect()
+left: x coordinate of the top left corner of the rectangle
+top: y coordinate of the top left corner of the rectangle
+width: width of the rectangle
+height: height of the rectangle
+color: color of the rectangle
+
+returns: false if the queue is full
+*/
+bool SH1106Lib::queueFillRect(int16_t left, int16_t top, uint8_t width, uint8_t height, uint8_t color)
+{
+	SH1106ClipArea area;
+	uint8_t right;
+
+	if (!_clip(left, top, width, height, area))
+	{ // nothing is visible
+		return true;
+	}
+
+	if (_rotation & 1)
+	{ // the rows of the rectangle are columns on the display
+		right = SH1106_LCDWIDTH - 1 - area.top;
+		area.top = area.left;
+		area.left = SH1106_LCDWIDTH - 1 - area.bottom;
+		area.bottom = area.right;
+		area.right = right;
+	}
+
+	return _queueJob(SH1106_JOB_FILLRECT, 0, 0, 0, 0, area, color, TRANSPARENT, NULL);
+}
+
+/*
+Queues a bitmap from the program memory, it will be drawn step by step by service()
+It is clipped (and moved by the origin) when it is queued, just like drawBitmap()
+x: the x coordinate to put the bitmap
+y: the y coordiante to put the bitmap
+bitmap: the byte array representing the image
+w: the width of the image
+h: the height of the image
+color: the color which the image should be displayed (BLACK/WHITE/INVERSE)
+backgroundType: SOLID or TRANSPARENT background
+
+returns: false if the queue is full
+*/
+bool SH1106Lib::queueBitmap(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType)
+{
+	SH1106ClipArea area;
+
+	if (!_clip(x, y, w, h, area))
+	{ // nothing is visible
+		return true;
+	}
+
+	return _queueJob((_rotation & 1) ? SH1106_JOB_TRANSPOSED : SH1106_JOB_BITMAP, x, y, w, h, area, color, backgroundType, bitmap);
+}
+
+/*
+Advances the queued drawing operations, until they are all done or the time runs out
+Every step writes at most SH1106_JOBSTEP_SIZE columns on one page (a bitmap queued in the 90 or 270 degrees
+rotation: on every page it covers). A step is only started if
+the previous one suggests it will fit into the remaining time, but at least one step is always done.
+maxMicros: the time budget in microseconds
+
+returns: true if there is nothing left in the queue
+*/
+bool SH1106Lib::service(uint16_t maxMicros)
+{
+	unsigned long start = micros();
+	unsigned long stepStart;
+	unsigned long elapsed = 0;
+	unsigned long lastStep = 0;
+
+	while (0 != _jobCount)
+	{
+		if (0 != elapsed && elapsed + lastStep > maxMicros)
+		{ // the next step would not fit
+			break;
+		}
+
+		stepStart = micros();
+		if (_stepJob(_jobs[_jobHead]))
+		{ // this one is done, move to the next
+			_jobHead = (_jobHead + 1) % SH1106_JOBQUEUE_SIZE;
+			_jobCount--;
+		}
+		lastStep = micros() - stepStart;
+		elapsed = micros() - start;
+	}
+
+	return 0 == _jobCount;
+}
+
+/*
+Tells whether all the queued drawing operations are done
+
+returns: true if there is nothing left in the queue
+*/
+bool SH1106Lib::isIdle()
+{
+	return 0 == _jobCount;
+}
+
+bool SH1106Lib::_queueJob(uint8_t type, int16_t x, int16_t y, uint8_t w, uint8_t h, const SH1106ClipArea &area, uint8_t color, uint8_t backgroundType, const byte *bitmap)
+{
+	if (_jobCount >= SH1106_JOBQUEUE_SIZE)
+	{ // no more room
+		return false;
+	}
+
+	SH1106Job &job = _jobs[(_jobHead + _jobCount) % SH1106_JOBQUEUE_SIZE];
+	job.type = type;
+	job.x = x;
+	job.y = y;
+	job.w = w;
+	job.h = h;
+	job.area = area;
+	job.color = color;
+	job.backgroundType = backgroundType;
+	job.bitmap = bitmap;
+	job.column = 0;
+	job.part = area.top >> 3;
+	_jobCount++;
+
+	return true;
+}
+
+bool SH1106Lib::_stepJob(SH1106Job &job)
+{
+	uint8_t columns = job.area.right - job.area.left + 1;
+	uint8_t count;
+
+	if (SH1106_JOB_TRANSPOSED == job.type)
+	{ // the rows of the screen are columns on the display, a step draws SH1106_JOBSTEP_SIZE of them
+		SH1106ClipArea rows = job.area;
+		rows.top += job.column;
+		if (rows.bottom - rows.top >= SH1106_JOBSTEP_SIZE)
+		{
+			rows.bottom = rows.top + SH1106_JOBSTEP_SIZE - 1;
+		}
+		_drawTransposed(job.x, job.y, job.bitmap, 1, job.w, job.w, job.h, job.color, job.backgroundType, false, rows);
+
+		job.column += rows.bottom - rows.top + 1;
+		return rows.bottom == job.area.bottom;
+	}
+
+	count = columns - job.column;
+	if (count > SH1106_JOBSTEP_SIZE)
+	{
+		count = SH1106_JOBSTEP_SIZE;
+	}
+
+	switch (job.type)
+	{
+	case SH1106_JOB_CLEAR:
+		_clearColumns(job.area.left + job.column, job.part, count);
+		break;
+	case SH1106_JOB_FILLRECT:
+		_drawColumns(job.area.left + job.column, job.part * SH1106_ROWHEIGHT, _rowMask(job.area.top, job.area.bottom, job.part), count, job.color);
+		break;
+	case SH1106_JOB_BITMAP:
+		_drawImagePage(job.x, job.y, job.bitmap, 1, job.w, intCeil(job.h, 8), job.part, job.area.left + job.column, count, _rowMask(job.area.top, job.area.bottom, job.part), job.color, job.backgroundType, false);
+		break;
+	}
+
+	job.column += count;
+	if (job.column < columns)
+	{ // there is more on this page
+		return false;
+	}
+
+	// move to the next page
+	job.column = 0;
+	job.part++;
+	return job.part > (job.area.bottom >> 3);
+}
+#endif
+
+#if SH1106_BUSSTATS
+/*
+Returns the I2C traffic counted since the last resetBusStats() call
+*/
+const SH1106BusStats& SH1106Lib::getBusStats()
+{
+	return _busStats;
+}
+
+/*
+Zeroes the I2C traffic counters
+*/
+void SH1106Lib::resetBusStats()
+{
+	_busStats.starts = 0;
+	_busStats.stops = 0;
+	_busStats.bytesWritten = 0;
+	_busStats.bytesRead = 0;
+}
+
+/*
+Calculates how long the counted traffic takes on the wire at the given bus speed
+Every byte is 9 clocks (8 bits + ACK/NACK), a START (or repeated START) is 1 clock, and a STOP is 1 clock plus the bus free time (~half a clock)
+stats: the traffic counters
+busFrequency: the SCL frequency in Hz (100000, 400000, 1000000...)
+
+returns: the modeled time in microseconds
+*/
+uint32_t SH1106Lib::modelBusTime(const SH1106BusStats& stats, uint32_t busFrequency)
+{
+	// everything is counted in half clock periods, to keep the math in integers
+	uint32_t halfClocks = (stats.bytesWritten + stats.bytesRead) * 18 + stats.starts * 2 + stats.stops * 3;
+	uint32_t halfClockNs = 500000000UL / busFrequency;
+
+	// split the multiplication, so it won't overflow on long runs
+	return (halfClocks / 1000) * halfClockNs + ((halfClocks % 1000) * halfClockNs) / 1000;
+}
+#endif
+
+/*
+Creates a tile map, with every cell set to tile 0
+tileset: the tiles in the program memory, 8 bytes (columns) per tile
+*/
+SH1106TileMap::SH1106TileMap(const byte *tileset)
+{
+	_tileset = tileset;
+	fill(0);
+}
+
+/*
+Changes the tileset, the whole map will be drawn again
+tileset: the tiles in the program memory, 8 bytes (columns) per tile
+*/
+void SH1106TileMap::setTileset(const byte *tileset)
+{
+	_tileset = tileset;
+	invalidate();
+}
+
+/*
+Sets a cell of the map. It is only marked for drawing if the tile is different from the current one
+column: the column of the cell 0..15
+row: the row of the cell 0..7
+tile: the index of the tile in the tileset
+*/
+void SH1106TileMap::setTile(uint8_t column, uint8_t row, uint8_t tile)
+{
+	if (column >= SH1106_TILEMAP_COLUMNS || row >= SH1106_TILEMAP_ROWS || tile == _tiles[row][column])
+	{ // outside of the map, or nothing changed
+		return;
+	}
+
+	_tiles[row][column] = tile;
+	_dirty[row] |= 1U << column;
+}
+
+/*
+Gets a cell of the map
+column: the column of the cell 0..15
+row: the row of the cell 0..7
+
+returns: the index of the tile in the tileset
+*/
+uint8_t SH1106TileMap::getTile(uint8_t column, uint8_t row)
+{
+	return _tiles[row][column];
+}
+
+/*
+Sets every cell of the map to the same tile, the whole map will be drawn again
+tile: the index of the tile in the tileset
+*/
+void SH1106TileMap::fill(uint8_t tile)
+{
+	memset(_tiles, tile, sizeof(_tiles));
+	invalidate();
+}
+
+/*
+Marks every cell for drawing
+*/
+void SH1106TileMap::invalidate()
+{
+	for (uint8_t row = 0; row < SH1106_TILEMAP_ROWS; row++)
+	{
+		_dirty[row] = 0xFFFF;
+	}
+}
+
+
+/*
+A fixed position text field, that only redraws the characters that have changed since the last update
+The characters are drawn with a SOLID background, so the old ones are overwritten
+*/
+class SH1106TextField
+{
+public:
+	SH1106TextField(SH1106Lib &display, uint8_t x, uint8_t y, uint8_t length, uint8_t align = ALIGN_LEFT, char padding = ' ');
+
+	void setFont(const unsigned char *font, uint8_t width, uint8_t height, int8_t offset = 0, uint8_t flags = FONT_FULL, uint8_t last = 0xFF);
+	void setFont(const SH1106Font *font);
+	void setColor(uint8_t color);
+	void setSize(uint8_t size);
+	void update(const char *text);
+	void invalidate();
+
+private:
+	SH1106Lib &_display;
+	uint8_t _x;
+	uint8_t _y;
+	uint8_t _length;
+	uint8_t _align;
+	char _padding;
+	uint8_t _color = WHITE;
+	uint8_t _size = 1;
+	const unsigned char *_font = NULL;
+	uint8_t _fontWidth = 5;
+	uint8_t _fontHeight = 8;
+	int8_t _fontOffset = 0;
+	uint8_t _fontFlags = FONT_FULL;
+	uint8_t _fontLast = 0xFF;
+	// what is on the display now, 0 means unknown
+	char _contents[SH1106_TEXTFIELD_LENGTH];
+};
+
+/*
+Creates a text field
+display: the display to draw on
+x: the x coordinate of the field
+y: the y coordinate of the field
+length: the number of characters in the field (at most SH1106_TEXTFIELD_LENGTH)
+align: ALIGN_LEFT, ALIGN_CENTER or ALIGN_RIGHT
+padding: the character to fill the unused part of the field with
+*/
+SH1106TextField::SH1106TextField(SH1106Lib &display, uint8_t x, uint8_t y, uint8_t length, uint8_t align/* = ALIGN_LEFT*/, char padding/* = ' '*/)
+	: _display(display), _x(x), _y(y), _align(align), _padding(padding)
+{
+	_length = (length > SH1106_TEXTFIELD_LENGTH) ? SH1106_TEXTFIELD_LENGTH : length;
+	invalidate();
+}
+
+/*
+Sets the font of the field. The parameters are the same as SH1106Lib::setFont's
+Note: update() makes this the current font of the display
+*/
+void SH1106TextField::setFont(const unsigned char *font, uint8_t width, uint8_t height, int8_t offset/* = 0*/, uint8_t flags/* = FONT_FULL*/, uint8_t last/* = 0xFF*/)
+{
+	_font = font;
+	_fontWidth = width;
+	_fontHeight = height;
+	_fontOffset = offset;
+	_fontFlags = flags;
+	_fontLast = last;
+	invalidate();
+}
+
+/*
+Sets the font of the field, from a font that knows its own properties
+font: the font (in the program memory)
+*/
+void SH1106TextField::setFont(const SH1106Font *font)
+{
+	SH1106Font header;
+
+	memcpy_P(&header, font, sizeof(SH1106Font));
+	setFont(header.data, header.width, header.height, header.offset, header.flags, header.last);
+}
+
+/*
+Sets the color of the characters
+color: BLACK or WHITE
+*/
+void SH1106TextField::setColor(uint8_t color)
+{
+	_color = color;
+	invalidate();
+}
+
+/*
+Sets how many times the characters are scaled up (see SH1106Lib::setTextSize)
+Note: update() makes this the current text size of the display
+size: 1..4
+*/
+void SH1106TextField::setSize(uint8_t size)
+{
+	_size = constrain(size, 1, SH1106_MAX_TEXTSIZE);
+	invalidate();
+}
+
+/*
+Displays the text in the field, only the characters that differ from the previous text are drawn
+The text is cut to the length of the field (left aligned text loses its end, right aligned text its beginning)
+text: the text to display
+*/
+void SH1106TextField::update(const char *text)
+{
+	uint8_t i;
+	uint8_t textLength = strlen(text);
+	uint8_t start = 0;
+	char c;
+
+	if (textLength > _length)
+	{ // does not fit, keep the aligned end of it
+		if (ALIGN_RIGHT == _align)
+		{
+			text += textLength - _length;
+		}
+		textLength = _length;
+	}
+
+	// where the text starts in the field
+	if (ALIGN_RIGHT == _align)
+	{
+		start = _length - textLength;
+	}
+	else if (ALIGN_CENTER == _align)
+	{
+		start = (_length - textLength) / 2;
+	}
+
+	if (NULL != _font)
+	{
+		_display.setFont(_font, _fontWidth, _fontHeight, _fontOffset, _fontFlags, _fontLast);
+	}
+	_display.setTextSize(_size);
+
+	for (i = 0; i < _length; i++)
+	{
+		c = (i < start || i >= start + textLength) ? _padding : text[i - start];
+		if (c != _contents[i])
+		{ // only draw the changed ones
+			_display.drawChar(_x + i * (_fontWidth + 1) * _size, _y, c, _color, SOLID);
+			_contents[i] = c;
+		}
+	}
+}
+
+/*
+Forgets what is on the display, so the next update() draws the whole field
+*/
+void SH1106TextField::invalidate()
+{
+	memset(_contents, 0, sizeof(_contents));
+}
+
+
+/*
+A sweep mode strip chart: every sample is drawn into the next column, as a line from the previous sample, like on an oscilloscope
+The column after the newest sample is kept empty, so the sweep can be followed when it wraps around, and nothing has to be cleared
+*/
+class SH1106StripChart
+{
+public:
+	SH1106StripChart(SH1106Lib &display, int16_t x, int16_t y, uint8_t w, uint8_t h, int16_t min, int16_t max);
+
+	void setColor(uint8_t color);
+	void push(int16_t sample);
+	void clear();
+
+private:
+	SH1106Lib &_display;
+	int16_t _x;
+	int16_t _y;
+	uint8_t _w;
+	uint8_t _h;
+	int16_t _min;
+	int16_t _max;
+	uint8_t _color = WHITE;
+	// where the next sample goes
+	uint8_t _column = 0;
+	// the row of the previous sample, 0xFF if there is none
+	uint8_t _lastRow = 0xFF;
+};
+
+/*
+Creates a strip chart
+display: the display to draw on
+x: the x coordinate of the plot area
+y: the y coordinate of the plot area
+w: the width of the plot area, one column per sample
+h: the height of the plot area
+min: the sample value at the bottom of the plot area
+max: the sample value at the top of the plot area
+*/
+SH1106StripChart::SH1106StripChart(SH1106Lib &display, int16_t x, int16_t y, uint8_t w, uint8_t h, int16_t min, int16_t max)
+	: _display(display), _x(x), _y(y), _w(w), _h(h), _min(min), _max(max)
+{
+}
+
+/*
+Sets the color of the trace, the background is the other one
+color: BLACK or WHITE
+*/
+void SH1106StripChart::setColor(uint8_t color)
+{
+	_color = color;
+}
+
+/*
+Adds a sample to the chart. It is drawn as a vertical line from the previous sample into the next column, then the column after it is erased
+Only these two columns are sent to the display, and only the pages the line touches are read back for the first one
+sample: the value to plot, values outside min..max are drawn at the edge of the plot area
+*/
+void SH1106StripChart::push(int16_t sample)
+{
+	uint8_t row, top, bottom;
+
+	if (0 == _w || 0 == _h)
+	{
+		return;
+	}
+
+	// the row of the sample, max is at the top
+	if (sample <= _min)
+	{
+		row = _h - 1;
+	}
+	else if (sample >= _max)
+	{
+		row = 0;
+	}
+	else
+	{
+		row = (_h - 1) - (uint8_t)(((int32_t)sample - _min) * (_h - 1) / ((int32_t)_max - _min));
+	}
+
+	// connect it to the previous one
+	top = row;
+	bottom = row;
+	if (0xFF != _lastRow)
+	{
+		if (_lastRow < top)
+		{
+			top = _lastRow;
+		}
+		else if (_lastRow > bottom)
+		{
+			bottom = _lastRow;
+		}
+	}
+
+	// the column was erased by the previous sample
+	_display.fillRect(_x + _column, _y + top, 1, bottom - top + 1, _color);
+	_lastRow = row;
+
+	_column++;
+	if (_column >= _w)
+	{
+		_column = 0;
+	}
+	if (_w > 1)
+	{ // erase the one ahead
+		_display.fillRect(_x + _column, _y, 1, _h, (WHITE == _color) ? BLACK : WHITE);
+	}
+}
+
+/*
+Erases the plot area, the next sample goes to its first column
+*/
+void SH1106StripChart::clear()
+{
+	_display.fillRect(_x, _y, _w, _h, (WHITE == _color) ? BLACK : WHITE);
+	_column = 0;
+	_lastRow = 0xFF;
+}
+
+
+/*
+Queues a single pixel (can be called from an ISR)
+x: the x coordinate to put the pixel
+y: the y coordiante to put the pixel
+color: the color of the pixel
+
+returns: false if the queue is full
+*/
+bool SH1106CommandQueue::pushPixel(int16_t x, int16_t y, uint8_t color)
+{
+	return _push(SH1106_CMD_PIXEL, x, y, 0, 0, color, TRANSPARENT, NULL);
+}
+
+/*
+Queues a filled rectangle (can be called from an ISR)
+The parameters are the same as SH1106Lib::fillRect's
+
+returns: false if the queue is full
+*/
+bool SH1106CommandQueue::pushFillRect(int16_t left, int16_t top, uint8_t width, uint8_t height, uint8_t color)
+{
+	return _push(SH1106_CMD_FILLRECT, left, top, width, height, color, TRANSPARENT, NULL);
+}
+
+/*
+Queues a bitmap from the program memory (can be called from an ISR)
+The parameters are the same as SH1106Lib::drawBitmap's
+
+returns: false if the queue is full
+*/
+bool SH1106CommandQueue::pushBitmap(int16_t x, int16_t y, const byte *bitmap, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType)
+{
+	return _push(SH1106_CMD_BITMAP, x, y, w, h, color, backgroundType, bitmap);
+}
+
+/*
+Queues a character (can be called from an ISR). It is drawn with the font that is set when the queue is drained
+The parameters are the same as SH1106Lib::drawChar's
+
+returns: false if the queue is full
+*/
+bool SH1106CommandQueue::pushChar(int16_t x, int16_t y, uint8_t character, uint8_t color, uint8_t backgroundType)
+{
+	return _push(SH1106_CMD_CHAR, x, y, character, 0, color, backgroundType, NULL);
+}
+
+/*
+Tells whether there are commands waiting in the queue
+
+returns: true if the queue is empty
+*/
+bool SH1106CommandQueue::isEmpty()
+{
+	return _head == _tail;
+}
+
+bool SH1106CommandQueue::peek(SH1106Command &command)
+{
+	uint8_t tail = _tail;
+
+	if (_head == tail)
+	{
+		return false;
+	}
+	// don't let the compiler read the command before the head
+	asm volatile("" ::: "memory");
+	command = _commands[tail];
+
+	return true;
+}
+
+void SH1106CommandQueue::pop()
+{
+	// the command has to be read, before the producer is allowed to overwrite it
+	asm volatile("" ::: "memory");
+	_tail = (_tail + 1) & (SH1106_COMMANDQUEUE_SIZE - 1);
+}
+
+bool SH1106CommandQueue::_push(uint8_t type, int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t color, uint8_t backgroundType, const byte *bitmap)
+{
+	uint8_t head = _head;
+	uint8_t next = (head + 1) & (SH1106_COMMANDQUEUE_SIZE - 1);
+
+	if (next == _tail)
+	{ // full
+		return false;
+	}
+
+	SH1106Command &command = _commands[head];
+	command.type = type;
+	command.x = x;
+	command.y = y;
+	command.w = w;
+	command.h = h;
+	command.color = color;
+	command.backgroundType = backgroundType;
+	command.bitmap = bitmap;
+
+	// the command has to be in place, before the consumer can see it
+	asm volatile("" ::: "memory");
+	_head = next;
+
+	return true;
+}
 
 
 #endif // _SH1106LIB_H
@@ -0,0 +1,93 @@
+/*
+ * SH1106Lib\Examples\Alert.ino
+ * Example sketch demonstrating the display effects: an alarm flashes the screen, and the screen is dimmed and
+ * then turned off, when it is not used. None of them redraws anything, they are a few command bytes each
+ * Connect a button between pin 2 and GND
+ * glcdfont.h is part of the Adafruit GFX Library:
+ * https://github.com/adafruit/Adafruit-GFX-Library/blob/master/glcdfont.c
+ *
+ * 2018, noti
+ */
+
+// config for softwareI2Cmaster lib
+#define I2C_HARDWARE 1
+#define I2C_TIMEOUT 10
+#define I2C_MAXWAIT 10
+#define I2C_PULLUP 1
+#define I2C_FASTMODE 1
+#define SDA_PORT PORTC
+#define SDA_PIN 4 // = A4
+#define SCL_PORT PORTC
+#define SCL_PIN 5 // = A5
+
+// config for tinyprint lib
+#define TP_PRINTLINES 0
+#define TP_FLASHSTRINGHELPER 1
+#define TP_NUMBERS 0
+#define TP_FLOAT 0
+#define TP_WINDOWSLINEENDS 0
+
+// sh1106 lib
+#define SH1106_EFFECTS 1
+
+#define BUTTON_PIN 2
+#define DIM_AFTER 10000
+#define SLEEP_AFTER 20000
+
+#include <SH1106Lib.h>
+#include "glcdfont.h"
+
+SH1106Lib display;
+unsigned long lastPress;
+bool asleep = false;
+bool dimmed = false;
+
+void setup() {
+	pinMode(BUTTON_PIN, INPUT_PULLUP);
+
+	display.initialize();
+	display.clearDisplay();
+
+	display.setFont(font, 5, 7);
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(0, 0);
+	display.print(F("Press the button to\nraise the alarm"));
+
+	lastPress = millis();
+}
+
+void loop() {
+	if (LOW == digitalRead(BUTTON_PIN))
+	{
+		if (asleep)
+		{ // the first press only wakes it up
+			display.wake();
+			asleep = false;
+		}
+		else
+		{ // the alarm
+			display.flash(5, 400);
+		}
+		if (dimmed)
+		{
+			display.fadeTo(159, 8, 200);
+			dimmed = false;
+		}
+		lastPress = millis();
+		delay(300);
+	}
+
+	if (!dimmed && millis() - lastPress > DIM_AFTER)
+	{
+		display.fadeTo(0, 16, 2000);
+		dimmed = true;
+	}
+	if (!asleep && millis() - lastPress > SLEEP_AFTER)
+	{
+		display.sleep();
+		asleep = true;
+	}
+
+	// the flash and the fade are advanced here
+	display.updateEffects();
+}
@@ -1,10 +1,16 @@
 /*
  * SH1106Lib\Examples\Benchmark.ino
- * A small "benchmark" sketch for testing speeds of different microcontrollers
+ * A deterministic benchmark sketch for comparing versions of the lib
+ * Every run draws the exact same workloads, counts the I2C traffic they generate, and converts it to the
+ * time it takes on the wire at 100kHz, 400kHz and 1MHz. The result is printed to the serial port as CSV,
+ * so the output of two versions of the lib can be diffed.
+ * The modeled times only depend on the traffic, so they are the same on every board. The measured_us
+ * column is the real time spent on the board the sketch is running on.
+ * The workloads are in BenchmarkWorkloads.h, extras/host runs the same ones on the computer.
  * Image conversion was made with: File to C style array converter https://notisrac.github.io/FileToCArray/
- * 
- * Warning: it will compile to ~5500 bytes, so it won't fit onto devices with 4k or less storage!
- * 
+ *
+ * Warning: it will compile to well over 5500 bytes, so it won't fit onto devices with 4k or less storage!
+ *
  * 2018, noti
  */
 
@@ -26,64 +32,62 @@
 #define TP_FLOAT 0
 #define TP_WINDOWSLINEENDS 0
 
-#define IMAGE_HEIGHT 5
-#define IMAGE_WIDTH 11
-
-// array size is 11
-static const byte data[] PROGMEM = {
-	B00011111, B00010001,
-	B00010001, B00010001,
-	B00010001, B00010001,
-	B00010001, B00010001,
-	B00011111, B00001010,
-	B00001110
-};
+// sh1106 lib
+#define SH1106_BUSSTATS 1
 
 #include "SH1106Lib.h"
 #include "font_3x5.h"
 
 SH1106Lib display;
 
+#include "BenchmarkWorkloads.h"
+
+unsigned long benchmarkStart;
+
+void startWorkload()
+{
+	rngState = 0xACE1;
+	display.resetBusStats();
+	benchmarkStart = micros();
+}
+
+void reportWorkload(const __FlashStringHelper *name)
+{
+	unsigned long measured = micros() - benchmarkStart;
+	const SH1106BusStats& stats = display.getBusStats();
+
+	Serial.print(name);
+	Serial.print(',');
+	Serial.print(stats.starts);
+	Serial.print(',');
+	Serial.print(stats.stops);
+	Serial.print(',');
+	Serial.print(stats.bytesWritten);
+	Serial.print(',');
+	Serial.print(stats.bytesRead);
+	Serial.print(',');
+	Serial.print(SH1106Lib::modelBusTime(stats, 100000));
+	Serial.print(',');
+	Serial.print(SH1106Lib::modelBusTime(stats, 400000));
+	Serial.print(',');
+	Serial.print(SH1106Lib::modelBusTime(stats, 1000000));
+	Serial.print(',');
+	Serial.println(measured);
+}
+
 void setup() {
+	Serial.begin(115200);
+
 	display.initialize();
 	display.clearDisplay();
-
-	display.setFont(font_3x5, FONT_3x5_WIDTH, FONT_3x5_HEIGHT, 45, FONT_NUMBERS | FONT_UPPERCASECHARS);
-	display.setTextWrap(true);
-	display.setTextColor(WHITE, TRANSPARENT);
 }
 
 void loop() {
-	// "start" the timer
-	unsigned long start = micros();
-
-	// bitmap
-	for (uint8_t i = 0; i < 64; i++)
-	{
-		display.drawBitmap(random(0, 110), random(0, 60), data, IMAGE_WIDTH, IMAGE_HEIGHT, WHITE, BLACK);
-	}
-
-	// text
-	display.setCursor(0, 0);
-	for (uint8_t i = 0; i < 65; i++)
-	{
-		display.print(F("ASD "));
-	}
-
-	// rectangles
-	for (uint8_t i = 0; i < 48; i++)
-	{
-		display.fillRect(random(0, 80), random(0, 40), 40, 20, i % 2);
-	}
-
-	// print the result
-	display.fillRect(18, 13, 84, 24, WHITE);
-	display.fillRect(20, 15, 80, 20, BLACK);
-	display.setCursor(35, 24);
-	long diff = micros() - start;
-	display.print(diff / 1000, DEC);
-	display.print(F(" MS"));
+	Serial.println(F("workload,starts,stops,bytes_written,bytes_read,model_us_100k,model_us_400k,model_us_1m,measured_us"));
+
+	runWorkloads();
 
+	Serial.println();
 
 	delay(2000);
 	display.clearDisplay();
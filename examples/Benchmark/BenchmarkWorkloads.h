@@ -0,0 +1,93 @@
+/*
+ * SH1106Lib\Examples\Benchmark\BenchmarkWorkloads.h
+ * The workloads of the benchmark. They are shared by the Benchmark sketch, that runs them on the board,
+ * and by the host benchmark in extras/host, that runs them against a model of the display controller.
+ * The file including it has to define display and include font_3x5.h first, and implement startWorkload()
+ * and reportWorkload(). startWorkload() has to reset rngState to 0xACE1, so every workload draws the same.
+ */
+
+#define IMAGE_HEIGHT 5
+#define IMAGE_WIDTH 11
+
+// array size is 11
+static const byte data[] PROGMEM = {
+	B00011111, B00010001,
+	B00010001, B00010001,
+	B00010001, B00010001,
+	B00010001, B00010001,
+	B00011111, B00001010,
+	B00001110
+};
+
+// a tiny xorshift generator, so the workloads are the same on every core (random() is not)
+uint16_t rngState;
+
+uint8_t rng(uint8_t max)
+{
+	rngState ^= rngState << 7;
+	rngState ^= rngState >> 9;
+	rngState ^= rngState << 8;
+	return rngState % max;
+}
+
+void startWorkload();
+void reportWorkload(const __FlashStringHelper *name);
+
+void runWorkloads()
+{
+	display.setFont(font_3x5, FONT_3x5_WIDTH, FONT_3x5_HEIGHT, 45, FONT_NUMBERS | FONT_UPPERCASECHARS, 'Z');
+	display.setTextWrap(true);
+
+	// clear
+	startWorkload();
+	display.clearDisplay();
+	reportWorkload(F("clear"));
+
+	// text page, page aligned
+	startWorkload();
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(0, 0);
+	for (uint8_t i = 0; i < 65; i++)
+	{
+		display.print(F("ASD "));
+	}
+	reportWorkload(F("text_aligned"));
+
+	// text page, crossing the page boundaries
+	display.clearDisplay();
+	startWorkload();
+	display.setTextColor(WHITE, SOLID);
+	display.setCursor(0, 3);
+	for (uint8_t i = 0; i < 65; i++)
+	{
+		display.print(F("ASD "));
+	}
+	reportWorkload(F("text_unaligned"));
+
+	// bitmaps
+	display.clearDisplay();
+	startWorkload();
+	for (uint8_t i = 0; i < 64; i++)
+	{
+		display.drawBitmap(rng(110), rng(60), data, IMAGE_WIDTH, IMAGE_HEIGHT, WHITE, (i & 1) ? SOLID : TRANSPARENT);
+	}
+	reportWorkload(F("bitmaps"));
+
+	// rectangles
+	display.clearDisplay();
+	startWorkload();
+	for (uint8_t i = 0; i < 48; i++)
+	{
+		display.fillRect(rng(80), rng(40), 40, 20, i % 2);
+	}
+	reportWorkload(F("fillrects"));
+
+	// pixels
+	display.clearDisplay();
+	startWorkload();
+	for (uint16_t i = 0; i < 256; i++)
+	{
+		display.drawPixel(rng(128), rng(64), WHITE);
+	}
+	reportWorkload(F("pixels"));
+}
@@ -0,0 +1,63 @@
+/*
+ * SH1106Lib\Examples\Incremental.ino
+ * Example sketch demonstrating how to draw without blocking a cooperative main loop
+ * The drawing operations are queued, and every loop() gives the display a 2ms time slice to advance them,
+ * so the rest of the loop runs on time, while the image builds up progressively across the ticks.
+ * Image conversion was made with: File to C style array converter https://notisrac.github.io/FileToCArray/
+ *
+ * 2018, noti
+ */
+
+// config for softwareI2Cmaster lib
+#define I2C_HARDWARE 1
+#define I2C_TIMEOUT 10
+#define I2C_MAXWAIT 10
+#define I2C_PULLUP 1
+#define I2C_FASTMODE 1
+#define SDA_PORT PORTC
+#define SDA_PIN 4 // = A4
+#define SCL_PORT PORTC
+#define SCL_PIN 5 // = A5
+
+// config for tinyprint lib
+#define TP_PRINTLINES 0
+#define TP_FLASHSTRINGHELPER 0
+#define TP_NUMBERS 0
+#define TP_FLOAT 0
+#define TP_WINDOWSLINEENDS 0
+
+// config for sh1106 lib
+#define SH1106_INCREMENTAL 1
+
+#include <SH1106Lib.h>
+#include "rick.h"
+
+SH1106Lib display;
+uint8_t x = 0;
+
+void setup() {
+	pinMode(LED_BUILTIN, OUTPUT);
+	display.initialize();
+	display.clearDisplay();
+}
+
+void loop() {
+	// the time critical work of the tick
+	digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+
+	// when the previous frame is done, queue the next one
+	if (display.isIdle())
+	{
+		display.queueClearDisplay();
+		display.queueBitmap(x, 3, data, IMAGE_WIDTH, IMAGE_HEIGHT, WHITE, SOLID);
+		display.queueFillRect(0, 0, 128, 1, WHITE);
+		x += 10;
+		if (x >= (128 - IMAGE_WIDTH))
+		{
+			x = 0;
+		}
+	}
+
+	// spend at most ~2ms on the display
+	display.service(2000);
+}
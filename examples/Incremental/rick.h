@@ -0,0 +1,73 @@
+/*
+ * Created with: https://notisrac.github.io/FileToCArray/
+ */
+#define IMAGE_HEIGHT 60
+#define IMAGE_WIDTH 48
+
+// array size is 384
+static const byte data[] PROGMEM = {
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B00001111, B11001111, B10011111,
+	B00111111, B01111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B01111111, B10111111, B00011111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B10111111, B00111111, B10111111, B10111111, B10111111, B10111111,
+	B10111111, B10111111, B10111111, B10000000, B11111111, B11111111,
+	B11111111, B11111110, B11111100, B01111011, B01110011, B01100111,
+	B01110011, B01111001, B11111110, B11111111, B11111110, B00000001,
+	B00111111, B10111111, B10111111, B10111111, B00111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B01111111, B01111111,
+	B01111111, B00111111, B10111110, B10011001, B11000111, B11111111,
+	B11111111, B11111111, B11111111, B00001111, B11110011, B11111101,
+	B11111110, B10011110, B10101110, B11010111, B11010111, B11101011,
+	B11101011, B11101011, B11101010, B11101010, B11010101, B10101011,
+	B10010111, B11101111, B11000111, B10011000, B10111111, B00111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111110, B11111101, B11111011,
+	B01111011, B10110111, B10110111, B11001111, B11011111, B11111111,
+	B11111111, B11111111, B00000011, B11111100, B11111111, B11111111,
+	B11100011, B11011101, B10111101, B10110101, B10111101, B10111101,
+	B10111101, B11011101, B01100001, B11101101, B00011101, B10110101,
+	B10111101, B00111101, B10011101, B11100000, B11111110, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111110,
+	B11111101, B11111101, B11111101, B11111011, B10000011, B10110111,
+	B10110001, B00101110, B11101111, B00001111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11100111, B11000111, B10000111,
+	B10000111, B10000111, B10000100, B10000011, B11000100, B11100111,
+	B11111111, B00000000, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B01111111,
+	B01111111, B10111100, B10011101, B10011101, B10111100, B11010011,
+	B00000111, B10110111, B01101111, B01101111, B01101111, B10101111,
+	B00001111, B10101111, B10101111, B10100111, B01110011, B01111100,
+	B01111110, B11111110, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B00000011, B11111000, B11111111,
+	B11111111, B11111111, B10111111, B00111111, B11000011, B11111011,
+	B11000000, B00111111, B11111111, B11111111, B11111111, B11111111,
+	B11110000, B00001110, B11111101, B11100011, B10011111, B01111111,
+	B01111110, B11111100, B11111001, B11110111, B11101111, B10011111,
+	B00111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B00001111, B00001111, B00001111, B00001111, B00001111, B00001111,
+	B00001111, B00001111, B00000001, B00001110, B00001111, B00001111,
+	B00001111, B00000011, B00001000, B00000111, B00001111, B00001111,
+	B00001111, B00000000, B00001111, B00001111, B00001111, B00001111,
+	B00001111, B00001110, B00000001, B00001111, B00000111, B00001011,
+	B00000000, B00001101, B00001011, B00000111, B00001111, B00001111,
+	B00001111, B00001110, B00001001, B00000011, B00001111, B00001111,
+	B00001111, B00001111, B00001111, B00001111, B00001111, B00001111 
+};
\ No newline at end of file
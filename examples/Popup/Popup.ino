@@ -0,0 +1,87 @@
+/*
+ * SH1106Lib\Examples\Popup.ino
+ * Example sketch demonstrating how to show a popup over the screen, and put back what was under it, without a framebuffer
+ * The area under the popup is read back from the display into a small buffer, and written back when the popup closes.
+ * Send 's' on the serial port to get a screenshot of the display as a binary PBM image.
+ * glcdfont.h is part of the Adafruit GFX Library:
+ * https://github.com/adafruit/Adafruit-GFX-Library/blob/master/glcdfont.c
+ *
+ * 2018, noti
+ */
+
+// config for softwareI2Cmaster lib
+#define I2C_HARDWARE 1
+#define I2C_TIMEOUT 10
+#define I2C_MAXWAIT 10
+#define I2C_PULLUP 1
+#define I2C_FASTMODE 1
+#define SDA_PORT PORTC
+#define SDA_PIN 4 // = A4
+#define SCL_PORT PORTC
+#define SCL_PIN 5 // = A5
+
+// config for tinyprint lib
+#define TP_PRINTLINES 0
+#define TP_FLASHSTRINGHELPER 1
+#define TP_NUMBERS 0
+#define TP_FLOAT 0
+#define TP_WINDOWSLINEENDS 0
+
+#include <SH1106Lib.h>
+#include "glcdfont.h"
+
+// the popup covers pages 2..4, in the middle of the display
+#define POPUP_X 24
+#define POPUP_PAGE 2
+#define POPUP_WIDTH 80
+#define POPUP_PAGES 3
+
+// printScreenshot() prints to a TinyPrint, this passes everything on to the serial port
+class SerialSink : public TinyPrint
+{
+public:
+	virtual byte write(uint8_t c) override
+	{
+		return Serial.write(c);
+	}
+};
+
+SH1106Lib display;
+SerialSink serialSink;
+// what was under the popup (80 * 3 bytes)
+byte saved[POPUP_WIDTH * POPUP_PAGES];
+
+void setup() {
+	Serial.begin(115200);
+
+	display.initialize();
+	display.clearDisplay();
+
+	// something to cover
+	display.setFont(font, 5, 7);
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(0, 0);
+	for (uint8_t i = 0; i < 21; i++)
+	{
+		display.print(F("Lorem ipsum "));
+	}
+}
+
+void loop() {
+	// save the area, and draw the popup over it
+	display.readRegion(POPUP_X, POPUP_PAGE, POPUP_WIDTH, POPUP_PAGES, saved);
+	display.fillRect(POPUP_X, POPUP_PAGE * 8, POPUP_WIDTH, POPUP_PAGES * 8, BLACK);
+	display.fillRect(POPUP_X, POPUP_PAGE * 8, POPUP_WIDTH, 1, WHITE);
+	display.fillRect(POPUP_X, POPUP_PAGE * 8 + POPUP_PAGES * 8 - 1, POPUP_WIDTH, 1, WHITE);
+	display.drawTextBox(POPUP_X + 4, POPUP_PAGE * 8 + 8, POPUP_WIDTH - 8, 8, "Low battery!", ALIGN_CENTER);
+	delay(1000);
+
+	if ('s' == Serial.read())
+	{ // save it with: the serial output > screenshot.pbm
+		display.printScreenshot(serialSink);
+	}
+
+	// the popup is gone, without redrawing the text under it
+	display.writeRegion(POPUP_X, POPUP_PAGE, POPUP_WIDTH, POPUP_PAGES, saved);
+	delay(1000);
+}
@@ -0,0 +1,156 @@
+/*
+ * SH1106Lib\Examples\Regression.ino
+ * Pixel exact regression test for the drawing functions of the lib
+ * Every case starts from a cleared display, draws something, then reads back the whole display memory
+ * and compares its CRC to the golden value stored in golden.h. The number of bytes that went over the
+ * bus is reported next to every case, so a change that is faster but wrong, or correct but slower,
+ * shows up immediately. The result is printed to the serial port as CSV.
+ * The cases are in RegressionCases.h, extras/host runs the same ones on the computer.
+ *
+ * To record new golden values (after an intentional change in the output), set REGRESSION_RECORD to 1,
+ * and replace the contents of golden.h with the output of the sketch (or run make record in extras/host).
+ *
+ * glcdfont.h is part of the Adafruit GFX Library:
+ * https://github.com/adafruit/Adafruit-GFX-Library/blob/master/glcdfont.c
+ *
+ * Warning: it needs the serial port and both fonts, so it won't fit onto devices with 8k or less storage!
+ */
+
+// softwareI2C lib
+#define I2C_HARDWARE 1
+#define I2C_TIMEOUT 10
+#define I2C_MAXWAIT 10
+#define I2C_PULLUP 1
+#define I2C_FASTMODE 1
+#define SDA_PORT PORTC
+#define SDA_PIN 4 // = A4
+#define SCL_PORT PORTC
+#define SCL_PIN 5 // = A5
+
+// tinyprint lib
+#define TP_PRINTLINES 0
+#define TP_FLASHSTRINGHELPER 1
+#define TP_NUMBERS 0
+#define TP_FLOAT 0
+#define TP_WINDOWSLINEENDS 0
+
+// sh1106 lib
+#define SH1106_BUSSTATS 1
+#define SH1106_INCREMENTAL 1
+
+// set it to 1 to print a new golden.h instead of checking the current one
+#define REGRESSION_RECORD 0
+
+#include "SH1106Lib.h"
+#include "glcdfont.h"
+#include "font_3x5.h"
+#include "golden.h"
+
+SH1106Lib display;
+uint8_t failures = 0;
+
+uint16_t crc16(uint16_t crc, byte data)
+{
+	crc ^= (uint16_t)data << 8;
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+	}
+	return crc;
+}
+
+/*
+The CRC of the visible part of the display memory, read back page by page
+*/
+uint16_t displayCrc()
+{
+	byte page[SH1106_LCDWIDTH];
+	uint16_t crc = 0xFFFF;
+
+	for (uint8_t j = 0; j < SH1106_NUMBEROF_PAGES; j++)
+	{
+		display.readRegion(0, j, SH1106_LCDWIDTH, 1, page);
+		for (uint8_t i = 0; i < SH1106_LCDWIDTH; i++)
+		{
+			crc = crc16(crc, page[i]);
+		}
+	}
+	return crc;
+}
+
+void beginCase()
+{
+	display.setRotation(0);
+	display.clearDisplay();
+	display.resetBusStats();
+}
+
+void endCase(const __FlashStringHelper *name, uint16_t golden)
+{
+	const SH1106BusStats& stats = display.getBusStats();
+	uint32_t busBytes = stats.bytesWritten + stats.bytesRead;
+	uint16_t crc = displayCrc();
+
+#if REGRESSION_RECORD
+	Serial.print(F("#define GOLDEN_"));
+	Serial.print(name);
+	Serial.print(F(" 0x"));
+	Serial.println(crc, HEX);
+#else
+	Serial.print(name);
+	Serial.print(',');
+	Serial.print(crc, HEX);
+	Serial.print(',');
+	Serial.print(golden, HEX);
+	Serial.print(',');
+	Serial.print(busBytes);
+	Serial.print(',');
+	if (crc == golden)
+	{
+		Serial.println(F("PASS"));
+	}
+	else
+	{
+		Serial.println(F("FAIL"));
+		failures++;
+	}
+#endif
+}
+
+/*
+Checks something about a case that the image does not show, e.g. the traffic on the bus
+*/
+void expect(const __FlashStringHelper *name, bool passed)
+{
+	if (!passed)
+	{
+		failures++;
+	}
+#if !REGRESSION_RECORD
+	Serial.print(name);
+	Serial.println(passed ? F(",,,,PASS") : F(",,,,FAIL"));
+#endif
+}
+
+#include "RegressionCases.h"
+
+void setup() {
+	Serial.begin(115200);
+
+	display.initialize();
+	display.setTextWrap(true);
+
+#if !REGRESSION_RECORD
+	Serial.println(F("case,crc,golden,bus_bytes,result"));
+#endif
+
+	runCases();
+
+#if !REGRESSION_RECORD
+	Serial.print(F("failures,"));
+	Serial.println(failures);
+#endif
+}
+
+void loop() {
+}
@@ -0,0 +1,593 @@
+/*
+ * SH1106Lib\Examples\Regression\RegressionCases.h
+ * The cases of the regression test. They are shared by the Regression sketch, that runs them on the board,
+ * and by the host test in extras/host, that runs them against a model of the display controller.
+ * The file including it has to define display, beginCase() and endCase() first, and include the fonts
+ * and golden.h.
+ */
+
+#define BATTERY_HEIGHT 5
+#define BATTERY_WIDTH 11
+
+// array size is 11
+static const byte battery[] PROGMEM = {
+	B00011111, B00010001,
+	B00010001, B00010001,
+	B00010001, B00010001,
+	B00010001, B00010001,
+	B00011111, B00001010,
+	B00001110
+};
+
+#define ARROW_HEIGHT 12
+#define ARROW_WIDTH 10
+
+// array size is 20
+static const byte arrow[] PROGMEM = {
+	B01100000, B01100000, B01100000, B01100000, B11111111, B11111110, B11111100, B11111000, B11110000, B01100000,
+	B00000000, B00000000, B00000000, B00000000, B00001111, B00000111, B00000011, B00000001, B00000000, B00000000
+};
+
+// array size is 24, 3 tiles: empty, a frame and a ball
+static const byte tileset[] PROGMEM = {
+	B00000000, B00000000, B00000000, B00000000, B00000000, B00000000, B00000000, B00000000,
+	B11111111, B10000001, B10000001, B10000001, B10000001, B10000001, B10000001, B11111111,
+	B00111100, B01111110, B11111111, B11111111, B11111111, B11111111, B01111110, B00111100
+};
+
+SH1106TileMap tileMap(tileset);
+
+// the same font with its range, so the characters after 'Z' are not read from past the end of it
+static const SH1106Font font3x5 PROGMEM = { font_3x5, FONT_3x5_WIDTH, FONT_3x5_HEIGHT, 45, FONT_NUMBERS | FONT_UPPERCASECHARS, 'Z' };
+
+#define BLOCK_HEIGHT 16
+#define BLOCK_WIDTH 8
+
+// array size is 16, the first page has all of its bits set, the second one has holes in it
+static const byte block[] PROGMEM = {
+	B11111111, B11111111, B11111111, B11111111, B11111111, B11111111, B11111111, B11111111,
+	B00001111, B00011111, B00111111, B01111111, B11111111, B11111110, B11111100, B11111000
+};
+
+// the same images in the row-major format (2 bytes per row, the leftmost pixel is the most significant bit)
+static const byte batteryRowMajor[] PROGMEM = {
+	B11111111, B10000000,
+	B10000000, B11100000,
+	B10000000, B10100000,
+	B10000000, B11100000,
+	B11111111, B10000000
+};
+
+static const byte arrowRowMajor[] PROGMEM = {
+	B00001000, B00000000,
+	B00001100, B00000000,
+	B00001110, B00000000,
+	B00001111, B00000000,
+	B00001111, B10000000,
+	B11111111, B11000000,
+	B11111111, B11000000,
+	B00001111, B10000000,
+	B00001111, B00000000,
+	B00001110, B00000000,
+	B00001100, B00000000,
+	B00001000, B00000000
+};
+
+// more than 255 characters, and more lines in a full screen box, than an SH1106TextLayout remembers
+// (there are no spaces, so every line is full, and the last lines start after the 255th character)
+static const char longText[] =
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+SH1106TextLayout layout = {};
+
+#define GRADIENT_HEIGHT 10
+#define GRADIENT_WIDTH 16
+
+// a grayscale image, one byte per pixel: dark on the left, light on the right
+static const byte gradient[] PROGMEM = {
+	0, 16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240,
+	1, 17, 33, 49, 65, 81, 97, 113, 129, 145, 161, 177, 193, 209, 225, 241,
+	2, 18, 34, 50, 66, 82, 98, 114, 130, 146, 162, 178, 194, 210, 226, 242,
+	3, 19, 35, 51, 67, 83, 99, 115, 131, 147, 163, 179, 195, 211, 227, 243,
+	4, 20, 36, 52, 68, 84, 100, 116, 132, 148, 164, 180, 196, 212, 228, 244,
+	5, 21, 37, 53, 69, 85, 101, 117, 133, 149, 165, 181, 197, 213, 229, 245,
+	6, 22, 38, 54, 70, 86, 102, 118, 134, 150, 166, 182, 198, 214, 230, 246,
+	7, 23, 39, 55, 71, 87, 103, 119, 135, 151, 167, 183, 199, 215, 231, 247,
+	8, 24, 40, 56, 72, 88, 104, 120, 136, 152, 168, 184, 200, 216, 232, 248,
+	9, 25, 41, 57, 73, 89, 105, 121, 137, 153, 169, 185, 201, 217, 233, 249
+};
+
+/*
+The same scene in every rotation, in the coordinates of the rotated drawing area: text, bitmaps,
+rectangles, a pattern and a grayscale image, and draws that hang over all four edges, so they have to be clipped
+*/
+void drawRotated(uint8_t rotation)
+{
+	// not symmetric to the diagonal, so a transposed pattern does not look the same
+	byte corner[8] = { 0x3F, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	display.setRotation(rotation);
+	display.fillRect(2, 3, 40, 20, WHITE);
+	display.setFont(font, 5, 7);
+	display.drawChar(6, 9, 'R', BLACK, SOLID);
+	display.drawBitmap(20, 5, arrow, ARROW_WIDTH, ARROW_HEIGHT, BLACK, TRANSPARENT);
+	display.drawBitmap(3, 30, battery, BATTERY_WIDTH, BATTERY_HEIGHT, WHITE, SOLID);
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(1, 50);
+	display.print(F("Rot"));
+	display.fillRectPattern(44, 2, 14, 26, corner);
+	display.drawGrayscaleBitmap(30, 28, gradient, GRADIENT_WIDTH, GRADIENT_HEIGHT);
+	// clipped at the edges
+	display.drawBitmap(-4, -6, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, SOLID);
+	display.fillRect(display.getWidth() - 8, display.getHeight() - 5, 20, 20, INVERSE);
+	display.drawChar(-3, display.getHeight() - 4, 'B', WHITE, TRANSPARENT);
+	display.drawBitmap(display.getWidth() - 5, 40, battery, BATTERY_WIDTH, BATTERY_HEIGHT, WHITE, TRANSPARENT);
+	display.drawGrayscaleBitmap(-3, display.getHeight() - 12, gradient, GRADIENT_WIDTH, GRADIENT_HEIGHT);
+	display.drawPixel(display.getWidth() - 1, 0, WHITE);
+	display.drawPixel(display.getWidth(), 0, WHITE);
+}
+
+/*
+Draws over the edges of the screen, of a viewport, and in the 90 degrees rotation, either directly or by queueing
+the same operations for service(), which clips them when they are queued
+*/
+void drawClipped(bool queued)
+{
+	display.setViewport(20, 10, 60, 40);
+	if (queued)
+	{
+		display.queueFillRect(-5, -5, 20, 20, WHITE);
+		display.queueBitmap(45, 30, battery, BATTERY_WIDTH, BATTERY_HEIGHT, INVERSE, SOLID);
+	}
+	else
+	{
+		display.fillRect(-5, -5, 20, 20, WHITE);
+		display.drawBitmap(45, 30, battery, BATTERY_WIDTH, BATTERY_HEIGHT, INVERSE, SOLID);
+	}
+
+	display.setRotation(1);
+	display.setOrigin(-3, 100);
+	if (queued)
+	{
+		display.queueBitmap(0, 0, arrow, ARROW_WIDTH, ARROW_HEIGHT, INVERSE, TRANSPARENT);
+		display.queueFillRect(10, 5, 60, 12, INVERSE);
+	}
+	else
+	{
+		display.drawBitmap(0, 0, arrow, ARROW_WIDTH, ARROW_HEIGHT, INVERSE, TRANSPARENT);
+		display.fillRect(10, 5, 60, 12, INVERSE);
+	}
+}
+
+void runCases()
+{
+	// fillRect
+	beginCase();
+	display.fillRect(0, 0, 128, 64, WHITE);
+	endCase(F("FILL_FULL"), GOLDEN_FILL_FULL);
+
+	beginCase();
+	display.fillRect(0, 8, 128, 16, WHITE);
+	endCase(F("FILL_ALIGNED"), GOLDEN_FILL_ALIGNED);
+
+	beginCase();
+	display.fillRect(5, 3, 40, 20, WHITE);
+	endCase(F("FILL_UNALIGNED"), GOLDEN_FILL_UNALIGNED);
+
+	beginCase();
+	display.fillRect(10, 9, 30, 5, WHITE);
+	endCase(F("FILL_INSIDE_PAGE"), GOLDEN_FILL_INSIDE_PAGE);
+
+	beginCase();
+	display.fillRect(100, 50, 40, 20, WHITE);
+	endCase(F("FILL_EDGE"), GOLDEN_FILL_EDGE);
+
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.fillRect(7, 6, 20, 19, BLACK);
+	endCase(F("FILL_BLACK"), GOLDEN_FILL_BLACK);
+
+	// drawBitmap
+	beginCase();
+	display.drawBitmap(3, 8, battery, BATTERY_WIDTH, BATTERY_HEIGHT, WHITE, TRANSPARENT);
+	display.drawBitmap(20, 16, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, TRANSPARENT);
+	endCase(F("BITMAP_ALIGNED"), GOLDEN_BITMAP_ALIGNED);
+
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.drawBitmap(3, 5, battery, BATTERY_WIDTH, BATTERY_HEIGHT, BLACK, TRANSPARENT);
+	display.drawBitmap(20, 13, arrow, ARROW_WIDTH, ARROW_HEIGHT, BLACK, TRANSPARENT);
+	endCase(F("BITMAP_BLACK_TRANSPARENT"), GOLDEN_BITMAP_BLACK_TRANSPARENT);
+
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.drawBitmap(3, 5, battery, BATTERY_WIDTH, BATTERY_HEIGHT, BLACK, SOLID);
+	display.drawBitmap(20, 13, arrow, ARROW_WIDTH, ARROW_HEIGHT, BLACK, SOLID);
+	endCase(F("BITMAP_BLACK_SOLID"), GOLDEN_BITMAP_BLACK_SOLID);
+
+	// the columns a transparent bitmap covers completely are not read back in the compose buffer
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.fillRect(2, 10, 40, 3, BLACK);
+	display.drawBitmap(4, 8, block, BLOCK_WIDTH, BLOCK_HEIGHT, BLACK, TRANSPARENT);
+	display.drawBitmap(16, 0, block, BLOCK_WIDTH, BLOCK_HEIGHT, BLACK, TRANSPARENT);
+	display.drawBitmap(28, 8, block, BLOCK_WIDTH, BLOCK_HEIGHT, WHITE, TRANSPARENT);
+	display.drawBitmap(40, 8, block, BLOCK_WIDTH, BLOCK_HEIGHT, INVERSE, TRANSPARENT);
+	display.drawBitmap(52, 12, block, BLOCK_WIDTH, BLOCK_HEIGHT, BLACK, TRANSPARENT);
+	endCase(F("BITMAP_COVERING"), GOLDEN_BITMAP_COVERING);
+
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.fillRect(2, 4, 30, 20, BLACK);
+	display.drawBitmap(3, 5, battery, BATTERY_WIDTH, BATTERY_HEIGHT, WHITE, SOLID);
+	display.drawBitmap(20, 13, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, SOLID);
+	endCase(F("BITMAP_WHITE_SOLID"), GOLDEN_BITMAP_WHITE_SOLID);
+
+	beginCase();
+	display.drawBitmap(120, 60, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, TRANSPARENT);
+	endCase(F("BITMAP_EDGE"), GOLDEN_BITMAP_EDGE);
+
+	// patterns and dithering
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		byte pattern[8];
+		SH1106Lib::ditherPattern(i * 8, pattern);
+		display.fillRectPattern(3 + i * 15, 5, 15, 50, pattern);
+	}
+	endCase(F("PATTERN_DITHER"), GOLDEN_PATTERN_DITHER);
+
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.drawGrayscaleBitmap(5, 3, gradient, GRADIENT_WIDTH, GRADIENT_HEIGHT);
+	display.drawGrayscaleBitmap(100, 58, gradient, GRADIENT_WIDTH, GRADIENT_HEIGHT);
+	endCase(F("GRAYSCALE"), GOLDEN_GRAYSCALE);
+
+	// drawBitmapRowMajor, it has to draw the same as drawBitmap
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.drawBitmapRowMajor(3, 5, batteryRowMajor, BATTERY_WIDTH, BATTERY_HEIGHT, BLACK, TRANSPARENT);
+	display.drawBitmapRowMajor(20, 13, arrowRowMajor, ARROW_WIDTH, ARROW_HEIGHT, BLACK, TRANSPARENT);
+	endCase(F("ROWMAJOR_BLACK_TRANSPARENT"), GOLDEN_BITMAP_BLACK_TRANSPARENT);
+
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.fillRect(2, 4, 30, 20, BLACK);
+	display.drawBitmapRowMajor(3, 5, batteryRowMajor, BATTERY_WIDTH, BATTERY_HEIGHT, WHITE, SOLID);
+	display.drawBitmapRowMajor(20, 13, arrowRowMajor, ARROW_WIDTH, ARROW_HEIGHT, WHITE, SOLID);
+	endCase(F("ROWMAJOR_WHITE_SOLID"), GOLDEN_BITMAP_WHITE_SOLID);
+
+	beginCase();
+	display.drawBitmapRowMajor(120, 60, arrowRowMajor, ARROW_WIDTH, ARROW_HEIGHT, WHITE, TRANSPARENT);
+	endCase(F("ROWMAJOR_EDGE"), GOLDEN_BITMAP_EDGE);
+
+	// text
+	beginCase();
+	display.setFont(font, 5, 7);
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(0, 0);
+	display.print(F("The quick brown fox jumps over the lazy dog 0123456789"));
+	endCase(F("TEXT_GLCD_ALIGNED"), GOLDEN_TEXT_GLCD_ALIGNED);
+
+	beginCase();
+	display.fillRect(0, 0, 128, 32, WHITE);
+	display.setTextColor(BLACK, SOLID);
+	display.setCursor(3, 5);
+	display.print(F("The quick brown fox jumps over the lazy dog 0123456789"));
+	endCase(F("TEXT_GLCD_UNALIGNED"), GOLDEN_TEXT_GLCD_UNALIGNED);
+
+	beginCase();
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.drawChar(0, 0, 'A', WHITE, TRANSPARENT);
+	display.drawChar(122, 0, 'B', WHITE, TRANSPARENT);
+	display.drawChar(0, 57, 'C', WHITE, TRANSPARENT);
+	display.drawChar(50, 20, '\x03', WHITE, SOLID);
+	endCase(F("TEXT_GLCD_CHARS"), GOLDEN_TEXT_GLCD_CHARS);
+
+	beginCase();
+	display.setFont(font_3x5, FONT_3x5_WIDTH, FONT_3x5_HEIGHT, 45, FONT_NUMBERS | FONT_UPPERCASECHARS, 'Z');
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(0, 0);
+	display.print(F("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789"));
+	display.setCursor(1, 43);
+	display.print(F("SPHINX OF BLACK QUARTZ 42"));
+	endCase(F("TEXT_3X5"), GOLDEN_TEXT_3X5);
+
+	// the characters that are not in the font are not drawn, the cursor still moves over them
+	beginCase();
+	display.setFont(&font3x5);
+	display.setTextColor(WHITE, SOLID);
+	display.setCursor(0, 0);
+	display.print(F("AZ,az!~09"));
+	display.drawChar(40, 8, 0xFF, WHITE, SOLID);
+	display.drawChar(45, 8, '@', WHITE, SOLID);
+	display.setRotation(1);
+	display.setTextSize(2);
+	display.drawChar(20, 20, 'a', WHITE, SOLID);
+	display.drawChar(30, 20, 'B', WHITE, SOLID);
+	display.setTextSize(1);
+	endCase(F("TEXT_NOT_IN_FONT"), GOLDEN_TEXT_NOT_IN_FONT);
+
+	beginCase();
+	display.setFont(font, 5, 7);
+	display.setTextSize(2);
+	display.setTextColor(WHITE, SOLID);
+	display.setCursor(0, 3);
+	display.print(F("12:34"));
+	display.setTextSize(3);
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(5, 30);
+	display.print(F("Big"));
+	display.setTextSize(1);
+	endCase(F("TEXT_SCALED"), GOLDEN_TEXT_SCALED);
+
+	// the scaled characters in the 90 and 270 degrees rotations, unaligned and over the edges
+	beginCase();
+	display.setRotation(1);
+	display.setFont(font, 5, 7);
+	display.setTextSize(2);
+	display.setTextColor(WHITE, SOLID);
+	display.setCursor(3, 5);
+	display.print(F("12"));
+	display.setTextSize(3);
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(1, 30);
+	display.print(F("Ag"));
+	display.fillRect(0, 60, 64, 30, WHITE);
+	display.drawChar(5, 63, 'x', BLACK, SOLID);
+	display.drawChar(30, 65, '#', INVERSE, SOLID);
+	display.drawChar(-7, 100, 'W', WHITE, TRANSPARENT);
+	display.drawChar(55, 120, 'M', WHITE, SOLID);
+	display.setRotation(3);
+	display.setTextSize(2);
+	display.drawChar(20, 2, 'Q', WHITE, TRANSPARENT);
+	display.setTextSize(1);
+	endCase(F("TEXT_SCALED_ROTATED"), GOLDEN_TEXT_SCALED_ROTATED);
+
+	// drawing the text box again from the layout has to draw the same, the lines that are not in the layout too
+	beginCase();
+	display.setFont(font_3x5, FONT_3x5_WIDTH, FONT_3x5_HEIGHT, 45, FONT_NUMBERS | FONT_UPPERCASECHARS, 'Z');
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.drawTextBox(1, 1, 126, 62, longText, ALIGN_LEFT, &layout);
+	endCase(F("TEXTBOX_LONG"), GOLDEN_TEXTBOX_LONG);
+
+	beginCase();
+	display.drawTextBox(1, 1, 126, 62, longText, ALIGN_LEFT, &layout);
+	endCase(F("TEXTBOX_LONG_CACHED"), GOLDEN_TEXTBOX_LONG);
+
+	// clipping
+	beginCase();
+	display.drawBitmap(-4, -6, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, SOLID);
+	display.drawBitmap(122, 58, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, SOLID);
+	display.fillRect(-10, 30, 20, 50, WHITE);
+	endCase(F("CLIP_OFFSCREEN"), GOLDEN_CLIP_OFFSCREEN);
+
+	beginCase();
+	display.setViewport(20, 10, 50, 30);
+	display.fillRect(-5, -5, 100, 8, WHITE);
+	display.drawBitmap(45, 25, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, TRANSPARENT);
+	display.setFont(font, 5, 7);
+	display.drawChar(-2, 12, 'A', WHITE, SOLID);
+	display.drawPixel(0, 29, WHITE);
+	display.drawPixel(50, 29, WHITE);
+	display.resetViewport();
+	endCase(F("CLIP_VIEWPORT"), GOLDEN_CLIP_VIEWPORT);
+
+	// inverse
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.fillRect(30, 10, 60, 40, INVERSE);
+	display.drawBitmap(3, 5, arrow, ARROW_WIDTH, ARROW_HEIGHT, INVERSE, SOLID);
+	display.drawChar(70, 3, 'X', INVERSE, TRANSPARENT);
+	display.drawPixel(100, 60, INVERSE);
+	endCase(F("INVERSE"), GOLDEN_INVERSE);
+
+	// drawing the same things again restores the FILL_BLACK image
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.fillRect(7, 6, 20, 19, BLACK);
+	display.fillRect(30, 10, 60, 40, INVERSE);
+	display.drawBitmap(3, 5, arrow, ARROW_WIDTH, ARROW_HEIGHT, INVERSE, SOLID);
+	display.drawChar(70, 3, 'X', INVERSE, TRANSPARENT);
+	display.fillRect(30, 10, 60, 40, INVERSE);
+	display.drawBitmap(3, 5, arrow, ARROW_WIDTH, ARROW_HEIGHT, INVERSE, SOLID);
+	display.drawChar(70, 3, 'X', INVERSE, TRANSPARENT);
+	endCase(F("INVERSE_TWICE"), GOLDEN_FILL_BLACK);
+
+	// the command queue, it has to draw the same as the direct calls
+	beginCase();
+	{
+		SH1106CommandQueue queue;
+		queue.pushBitmap(-4, -6, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, SOLID);
+		queue.pushBitmap(122, 58, arrow, ARROW_WIDTH, ARROW_HEIGHT, WHITE, SOLID);
+		queue.pushFillRect(-10, 30, 20, 50, WHITE);
+		display.drainCommands(queue);
+	}
+	endCase(F("QUEUE_CLIP"), GOLDEN_CLIP_OFFSCREEN);
+
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.setFont(font, 5, 7);
+	{
+		SH1106CommandQueue queue;
+		queue.pushChar(10, 3, 'Q', BLACK, SOLID);
+		queue.pushChar(16, 3, 'u', INVERSE, TRANSPARENT);
+		queue.pushFillRect(22, 2, 3, 9, BLACK);
+		queue.pushPixel(26, 4, BLACK);
+		queue.pushPixel(26, 4, INVERSE);
+		queue.pushBitmap(28, 1, battery, BATTERY_WIDTH, BATTERY_HEIGHT, BLACK, TRANSPARENT);
+		queue.pushPixel(-1, 5, BLACK);
+		display.drainCommands(queue);
+	}
+	endCase(F("QUEUE_MIXED"), GOLDEN_QUEUE_MIXED);
+
+	// readRegion, the copy has to match the original
+	beginCase();
+	display.fillRect(0, 0, 64, 32, WHITE);
+	display.drawBitmap(20, 13, arrow, ARROW_WIDTH, ARROW_HEIGHT, BLACK, TRANSPARENT);
+	display.setFont(font, 5, 7);
+	display.drawChar(40, 10, 'R', BLACK, SOLID);
+	{
+		byte region[30 * 3];
+		display.readRegion(15, 1, 30, 3, region);
+		display.writeRegion(80, 4, 30, 3, region);
+	}
+	endCase(F("READBACK"), GOLDEN_READBACK);
+
+	// regions over the edges are cut, the column pointer must not wrap around, and there is no page 8
+	beginCase();
+	display.fillRect(100, 40, 28, 24, WHITE);
+	display.fillRect(122, 50, 3, 3, BLACK);
+	{
+		byte region[16 * 4];
+		memset(region, 0x55, sizeof(region));
+		display.readRegion(120, 6, 16, 4, region);
+		display.writeRegion(0, 0, 16, 4, region);
+		display.writeRegion(120, 0, 16, 4, region);
+		display.writeRegion(40, 6, 16, 4, region);
+	}
+	endCase(F("REGION_EDGES"), GOLDEN_REGION_EDGES);
+
+	// the tiles are sent in write-only bursts, a run of neighbouring dirty tiles in one
+	beginCase();
+	tileMap.fill(0);
+	for (uint8_t i = 0; i < SH1106_TILEMAP_COLUMNS; i++)
+	{
+		tileMap.setTile(i, 0, 1);
+		tileMap.setTile(i, SH1106_TILEMAP_ROWS - 1, 1);
+	}
+	tileMap.setTile(5, 3, 2);
+	display.renderTiles(tileMap);
+	display.resetBusStats();
+	// two runs: the ball moves from 5 to 6 on row 3, and a single tile on row 5
+	tileMap.setTile(5, 3, 0);
+	tileMap.setTile(6, 3, 2);
+	tileMap.setTile(9, 5, 2);
+	display.renderTiles(tileMap);
+	// nothing is read, and only the 3 tiles are sent, with the position and the control bytes of the 2 bursts
+	expect(F("TILEMAP_NO_READS"), 0 == display.getBusStats().bytesRead && 3 * SH1106_TILE_SIZE + 2 * 12 == display.getBusStats().bytesWritten);
+	display.resetBusStats();
+	display.renderTiles(tileMap);
+	expect(F("TILEMAP_NOTHING_DIRTY"), 0 == display.getBusStats().starts && 0 == display.getBusStats().bytesWritten);
+	endCase(F("TILEMAP"), GOLDEN_TILEMAP);
+
+	// a text field only redraws the characters that changed: the traffic is the same as drawing that one character
+	beginCase();
+	{
+		SH1106TextField field(display, 10, 20, 6, ALIGN_RIGHT);
+		uint32_t fieldBytes;
+
+		field.setFont(font, 5, 7);
+		field.update("12:34");
+		display.resetBusStats();
+		field.update("12:35");
+		fieldBytes = display.getBusStats().bytesWritten + display.getBusStats().bytesRead;
+		// the same character again, at the last place of the field, it does not change the image
+		display.resetBusStats();
+		display.drawChar(10 + 5 * 6, 20, '5', WHITE, SOLID);
+		expect(F("TEXTFIELD_ONE_GLYPH"), 0 != fieldBytes && fieldBytes == display.getBusStats().bytesWritten + display.getBusStats().bytesRead);
+	}
+	endCase(F("TEXTFIELD"), GOLDEN_TEXTFIELD);
+
+	// the strip chart, pushed past its width twice, so it wraps around and scrolls over the old trace
+	beginCase();
+	{
+		SH1106StripChart chart(display, 10, 12, 40, 30, 0, 100);
+		chart.clear();
+		for (uint8_t i = 0; i < 95; i++)
+		{
+			// a triangle wave, going out of min..max at both ends
+			chart.push((i % 30 < 15) ? (i % 30) * 10 - 20 : (30 - i % 30) * 10 - 20);
+		}
+	}
+	endCase(F("STRIPCHART"), GOLDEN_STRIPCHART);
+
+	// the queued operations, done step by step by service(), have to draw the same as the direct calls
+	beginCase();
+	display.fillRect(0, 0, 128, 64, WHITE);
+	display.clearDisplay();
+	display.fillRect(5, 3, 70, 30, WHITE);
+	display.drawBitmap(20, 13, battery, BATTERY_WIDTH, BATTERY_HEIGHT, BLACK, SOLID);
+	display.drawBitmap(100, 58, arrow, ARROW_WIDTH, ARROW_HEIGHT, INVERSE, TRANSPARENT);
+	endCase(F("JOBS_DIRECT"), GOLDEN_JOBS_DIRECT);
+
+	beginCase();
+	display.queueFillRect(0, 0, 128, 64, WHITE);
+	display.queueClearDisplay();
+	display.queueFillRect(5, 3, 70, 30, WHITE);
+	display.queueBitmap(20, 13, battery, BATTERY_WIDTH, BATTERY_HEIGHT, BLACK, SOLID);
+	{
+		bool arrowQueued = false;
+		uint16_t calls = 0;
+
+		// a budget of a few columns, so it takes many calls. The queue has no room for the last one at first
+		do
+		{
+			if (!arrowQueued)
+			{
+				arrowQueued = display.queueBitmap(100, 58, arrow, ARROW_WIDTH, ARROW_HEIGHT, INVERSE, TRANSPARENT);
+			}
+			calls++;
+		} while (!display.service(400) || !arrowQueued);
+		expect(F("JOBS_IN_STEPS"), calls > 20 && display.isIdle());
+	}
+	expect(F("JOBS_SAME_AS_DIRECT"), GOLDEN_JOBS_DIRECT == displayCrc());
+	endCase(F("JOBS_SERVICE"), GOLDEN_JOBS_SERVICE);
+
+	beginCase();
+	drawClipped(false);
+	endCase(F("JOBS_CLIPPED_DIRECT"), GOLDEN_JOBS_CLIPPED_DIRECT);
+
+	beginCase();
+	drawClipped(true);
+	while (!display.service(400))
+	{
+	}
+	expect(F("JOBS_CLIPPED_SAME_AS_DIRECT"), GOLDEN_JOBS_CLIPPED_DIRECT == displayCrc());
+	endCase(F("JOBS_CLIPPED_SERVICE"), GOLDEN_JOBS_CLIPPED_SERVICE);
+
+	// drawPixel
+	beginCase();
+	for (uint8_t y = 0; y < SH1106_LCDHEIGHT; y++)
+	{
+		display.drawPixel(y * 2, y, WHITE);
+	}
+	endCase(F("PIXEL_ALIGNMENTS"), GOLDEN_PIXEL_ALIGNMENTS);
+
+	beginCase();
+	display.drawPixel(0, 0, WHITE);
+	display.drawPixel(127, 0, WHITE);
+	display.drawPixel(0, 63, WHITE);
+	display.drawPixel(127, 63, WHITE);
+	display.drawPixel(128, 10, WHITE);
+	endCase(F("PIXEL_EDGES"), GOLDEN_PIXEL_EDGES);
+
+	beginCase();
+	display.fillRect(0, 0, 16, 16, WHITE);
+	for (uint8_t y = 0; y < 16; y++)
+	{
+		display.drawPixel(y, y, BLACK);
+	}
+	endCase(F("PIXEL_BLACK"), GOLDEN_PIXEL_BLACK);
+
+	// rotation, the cases stay rotated until endCase, so the scan directions are checked as well
+	beginCase();
+	drawRotated(1);
+	endCase(F("ROTATION_1"), GOLDEN_ROTATION_1);
+
+	beginCase();
+	drawRotated(2);
+	endCase(F("ROTATION_2"), GOLDEN_ROTATION_2);
+
+	beginCase();
+	drawRotated(3);
+	endCase(F("ROTATION_3"), GOLDEN_ROTATION_3);
+}
@@ -0,0 +1,17 @@
+/*
+ * Created with: https://notisrac.github.io/FileToCArray/
+ */
+#define FONT_3x5_HEIGHT 5
+#define FONT_3x5_WIDTH 4
+
+// array size is 184
+static const unsigned char font_3x5[] PROGMEM = {
+	B00000100, B00000100, B00000100, B00000000, B00000000, B00010000, B00000000, B00000000, B00010000, B00001110, B00000001, B00000000, B00011111, B00010001, B00011111, B00000000, B00000010, B00011111, B00000000, B00000000, B00011101, B00010101, B00010111,
+	B00000000, B00010001, B00010101, B00011111, B00000000, B00000111, B00000100, B00011110, B00000000, B00010111, B00010101, B00011101, B00000000, B00011111, B00010101, B00011101, B00000000, B00000001, B00011101, B00000011, B00000000, B00011111, B00010101,
+	B00011111, B00000000, B00010111, B00010101, B00011111, B00000000, B00000000, B00001010, B00000000, B00000000, B00010000, B00011010, B00000000, B00000000, B00000100, B00001010, B00010001, B00000000, B00001010, B00001010, B00001010, B00000000, B00010001,
+	B00001010, B00000100, B00000000, B00000001, B00010101, B00000010, B00000000, B00001110, B00010111, B00010110, B00000000, B00011111, B00000101, B00011111, B00000000, B00011111, B00010101, B00001010, B00000000, B00001110, B00010001, B00010001, B00000000,
+	B00011111, B00010001, B00001110, B00000000, B00011111, B00010101, B00010001, B00000000, B00011111, B00000101, B00000001, B00000000, B00011111, B00010001, B00011101, B00000000, B00011111, B00000100, B00011111, B00000000, B00000000, B00011111, B00000000,
+	B00000000, B00011000, B00010000, B00011111, B00000000, B00011111, B00000100, B00011011, B00000000, B00011111, B00010000, B00010000, B00000000, B00011111, B00000010, B00011111, B00000000, B00011110, B00000100, B00001111, B00000000, B00001110, B00010001,
+	B00001110, B00000000, B00011111, B00000101, B00000010, B00000000, B00001110, B00010001, B00011110, B00000000, B00011111, B00000101, B00011010, B00000000, B00010010, B00010101, B00001001, B00000000, B00000001, B00011111, B00000001, B00000000, B00011111,
+	B00010000, B00011111, B00000000, B00001111, B00010000, B00001111, B00000000, B00011111, B00001000, B00011111, B00000000, B00011011, B00000100, B00011011, B00000000, B00000011, B00011100, B00000011, B00000000, B00011001, B00010101, B00010011, B00000000
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+ * Golden CRC values for the Regression example
+ * Recorded with REGRESSION_RECORD set to 1, or with make record in extras/host
+ */
+#define GOLDEN_FILL_FULL 0x77EB
+#define GOLDEN_FILL_ALIGNED 0x2D71
+#define GOLDEN_FILL_UNALIGNED 0x8B2D
+#define GOLDEN_FILL_INSIDE_PAGE 0xB48E
+#define GOLDEN_FILL_EDGE 0xECDC
+#define GOLDEN_FILL_BLACK 0x2A32
+#define GOLDEN_BITMAP_ALIGNED 0x6CC8
+#define GOLDEN_BITMAP_BLACK_TRANSPARENT 0xA190
+#define GOLDEN_BITMAP_BLACK_SOLID 0xA190
+#define GOLDEN_BITMAP_COVERING 0x792
+#define GOLDEN_BITMAP_WHITE_SOLID 0x6E1B
+#define GOLDEN_BITMAP_EDGE 0xFCF
+#define GOLDEN_PATTERN_DITHER 0x6B5C
+#define GOLDEN_GRAYSCALE 0xD863
+#define GOLDEN_ROWMAJOR_BLACK_TRANSPARENT 0xA190
+#define GOLDEN_ROWMAJOR_WHITE_SOLID 0x6E1B
+#define GOLDEN_ROWMAJOR_EDGE 0xFCF
+#define GOLDEN_TEXT_GLCD_ALIGNED 0xA0A1
+#define GOLDEN_TEXT_GLCD_UNALIGNED 0x6A43
+#define GOLDEN_TEXT_GLCD_CHARS 0x3E19
+#define GOLDEN_TEXT_3X5 0xEF6
+#define GOLDEN_TEXT_NOT_IN_FONT 0x91BE
+#define GOLDEN_TEXT_SCALED 0xEE0D
+#define GOLDEN_TEXT_SCALED_ROTATED 0x5CF0
+#define GOLDEN_TEXTBOX_LONG 0x7BC6
+#define GOLDEN_TEXTBOX_LONG_CACHED 0x7BC6
+#define GOLDEN_CLIP_OFFSCREEN 0xF83D
+#define GOLDEN_CLIP_VIEWPORT 0x98D7
+#define GOLDEN_INVERSE 0xB3C8
+#define GOLDEN_INVERSE_TWICE 0x2A32
+#define GOLDEN_QUEUE_CLIP 0xF83D
+#define GOLDEN_QUEUE_MIXED 0xF3A1
+#define GOLDEN_READBACK 0x133E
+#define GOLDEN_REGION_EDGES 0x8562
+#define GOLDEN_TILEMAP 0x6F71
+#define GOLDEN_TEXTFIELD 0xCCCC
+#define GOLDEN_STRIPCHART 0x407A
+#define GOLDEN_JOBS_DIRECT 0x7F25
+#define GOLDEN_JOBS_SERVICE 0x7F25
+#define GOLDEN_JOBS_CLIPPED_DIRECT 0xF1B
+#define GOLDEN_JOBS_CLIPPED_SERVICE 0xF1B
+#define GOLDEN_PIXEL_ALIGNMENTS 0x7153
+#define GOLDEN_PIXEL_EDGES 0xE062
+#define GOLDEN_PIXEL_BLACK 0x7B50
+#define GOLDEN_ROTATION_1 0x42BF
+#define GOLDEN_ROTATION_2 0x7A2D
+#define GOLDEN_ROTATION_3 0x42BF
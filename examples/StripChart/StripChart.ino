@@ -0,0 +1,51 @@
+/*
+ * SH1106Lib\Examples\StripChart.ino
+ * Example sketch demonstrating how to plot a live sensor trace, without redrawing the plot for every sample
+ * Connect a potentiometer (or any analog sensor) to A0
+ *
+ * 2018, noti
+ */
+
+// config for softwareI2Cmaster lib
+#define I2C_HARDWARE 1
+#define I2C_TIMEOUT 10
+#define I2C_MAXWAIT 10
+#define I2C_PULLUP 1
+#define I2C_FASTMODE 1
+#define SDA_PORT PORTC
+#define SDA_PIN 4 // = A4
+#define SCL_PORT PORTC
+#define SCL_PIN 5 // = A5
+
+// config for tinyprint lib
+#define TP_PRINTLINES 0
+#define TP_FLASHSTRINGHELPER 1
+#define TP_NUMBERS 0
+#define TP_FLOAT 0
+#define TP_WINDOWSLINEENDS 0
+
+#include <SH1106Lib.h>
+
+SH1106Lib display;
+// the plot area is 120x48 pixels, with a 1 pixel frame around it. The analogRead range is 0..1023
+SH1106StripChart chart(display, 4, 8, 120, 48, 0, 1023);
+
+void setup() {
+	display.initialize();
+	display.clearDisplay();
+
+	// the frame is only drawn once
+	display.fillRect(3, 7, 122, 1, WHITE);
+	display.fillRect(3, 56, 122, 1, WHITE);
+	display.fillRect(3, 8, 1, 48, WHITE);
+	display.fillRect(124, 8, 1, 48, WHITE);
+
+	chart.clear();
+}
+
+void loop() {
+	// every sample only sends two columns of the plot to the display
+	chart.push(analogRead(A0));
+
+	delay(20);
+}
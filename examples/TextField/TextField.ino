@@ -0,0 +1,63 @@
+/*
+ * SH1106Lib\Examples\TextField.ino
+ * Example sketch demonstrating how to update numeric readouts, by only redrawing the characters that changed
+ * glcdfont.h is part of the Adafruit GFX Library:
+ * https://github.com/adafruit/Adafruit-GFX-Library/blob/master/glcdfont.c
+ *
+ * 2018, noti
+ */
+
+// config for softwareI2Cmaster lib
+#define I2C_HARDWARE 1
+#define I2C_TIMEOUT 10
+#define I2C_MAXWAIT 10
+#define I2C_PULLUP 1
+#define I2C_FASTMODE 1
+#define SDA_PORT PORTC
+#define SDA_PIN 4 // = A4
+#define SCL_PORT PORTC
+#define SCL_PIN 5 // = A5
+
+// config for tinyprint lib
+#define TP_PRINTLINES 0
+#define TP_FLASHSTRINGHELPER 1
+#define TP_NUMBERS 0
+#define TP_FLOAT 0
+#define TP_WINDOWSLINEENDS 0
+
+#include <SH1106Lib.h>
+#include "glcdfont.h"
+
+SH1106Lib display;
+// an 8 character wide, right aligned field for the uptime
+SH1106TextField uptime(display, 72, 8, 8, ALIGN_RIGHT);
+// a left aligned one for the state
+SH1106TextField state(display, 72, 24, 8);
+
+void setup() {
+	display.initialize();
+	display.clearDisplay();
+
+	// the labels are only drawn once
+	display.setFont(font, 5, 7);
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(0, 8);
+	display.print(F("Uptime:"));
+	display.setCursor(0, 24);
+	display.print(F("State:"));
+
+	uptime.setFont(font, 5, 7);
+	state.setFont(font, 5, 7);
+}
+
+void loop() {
+	char text[9];
+
+	// most of the time only the last digit changes, so only that one is sent to the display
+	ltoa(millis() / 1000, text, 10);
+	uptime.update(text);
+
+	state.update((millis() / 5000) % 2 ? "running" : "idle");
+
+	delay(1000);
+}
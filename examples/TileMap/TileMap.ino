@@ -0,0 +1,98 @@
+/*
+ * SH1106Lib\Examples\TileMap.ino
+ * Example sketch demonstrating how to build a screen from 8x8 tiles, where only the changed tiles are sent to the display
+ * The tiles are written without reading back the display, and the neighbouring ones go out in a single burst.
+ *
+ * 2018, noti
+ */
+
+// config for softwareI2Cmaster lib
+#define I2C_HARDWARE 1
+#define I2C_TIMEOUT 10
+#define I2C_MAXWAIT 10
+#define I2C_PULLUP 1
+#define I2C_FASTMODE 1
+#define SDA_PORT PORTC
+#define SDA_PIN 4 // = A4
+#define SCL_PORT PORTC
+#define SCL_PIN 5 // = A5
+
+// config for tinyprint lib
+#define TP_PRINTLINES 0
+#define TP_FLASHSTRINGHELPER 0
+#define TP_NUMBERS 0
+#define TP_FLOAT 0
+#define TP_WINDOWSLINEENDS 0
+
+#include <SH1106Lib.h>
+
+#define TILE_EMPTY 0
+#define TILE_HORIZONTAL 1
+#define TILE_VERTICAL 2
+#define TILE_CORNER_TOPLEFT 3
+#define TILE_CORNER_TOPRIGHT 4
+#define TILE_CORNER_BOTTOMLEFT 5
+#define TILE_CORNER_BOTTOMRIGHT 6
+#define TILE_BALL 7
+
+// 8 bytes (columns) per tile, the least significant bit is the top pixel
+static const byte tiles[] PROGMEM = {
+	B00000000, B00000000, B00000000, B00000000, B00000000, B00000000, B00000000, B00000000, // empty
+	B00011000, B00011000, B00011000, B00011000, B00011000, B00011000, B00011000, B00011000, // horizontal line
+	B00000000, B00000000, B00000000, B11111111, B11111111, B00000000, B00000000, B00000000, // vertical line
+	B00000000, B00000000, B00000000, B11111000, B11111000, B00011000, B00011000, B00011000, // top left corner
+	B00011000, B00011000, B00011000, B11111000, B11111000, B00000000, B00000000, B00000000, // top right corner
+	B00000000, B00000000, B00000000, B00011111, B00011111, B00011000, B00011000, B00011000, // bottom left corner
+	B00011000, B00011000, B00011000, B00011111, B00011111, B00000000, B00000000, B00000000, // bottom right corner
+	B00111100, B01111110, B11111111, B11111111, B11111111, B11111111, B01111110, B00111100  // ball
+};
+
+SH1106Lib display;
+SH1106TileMap screen(tiles);
+uint8_t ballX = 1;
+uint8_t ballY = 1;
+int8_t directionX = 1;
+int8_t directionY = 1;
+
+void setup() {
+	display.initialize();
+
+	// a frame around the display
+	for (uint8_t i = 1; i < SH1106_TILEMAP_COLUMNS - 1; i++)
+	{
+		screen.setTile(i, 0, TILE_HORIZONTAL);
+		screen.setTile(i, SH1106_TILEMAP_ROWS - 1, TILE_HORIZONTAL);
+	}
+	for (uint8_t i = 1; i < SH1106_TILEMAP_ROWS - 1; i++)
+	{
+		screen.setTile(0, i, TILE_VERTICAL);
+		screen.setTile(SH1106_TILEMAP_COLUMNS - 1, i, TILE_VERTICAL);
+	}
+	screen.setTile(0, 0, TILE_CORNER_TOPLEFT);
+	screen.setTile(SH1106_TILEMAP_COLUMNS - 1, 0, TILE_CORNER_TOPRIGHT);
+	screen.setTile(0, SH1106_TILEMAP_ROWS - 1, TILE_CORNER_BOTTOMLEFT);
+	screen.setTile(SH1106_TILEMAP_COLUMNS - 1, SH1106_TILEMAP_ROWS - 1, TILE_CORNER_BOTTOMRIGHT);
+
+	// the first render draws the whole display, so there is no need for clearDisplay()
+	display.renderTiles(screen);
+}
+
+void loop() {
+	// move the ball, only the two changed tiles are sent to the display
+	screen.setTile(ballX, ballY, TILE_EMPTY);
+	if (ballX + directionX == 0 || ballX + directionX == SH1106_TILEMAP_COLUMNS - 1)
+	{
+		directionX = -directionX;
+	}
+	if (ballY + directionY == 0 || ballY + directionY == SH1106_TILEMAP_ROWS - 1)
+	{
+		directionY = -directionY;
+	}
+	ballX += directionX;
+	ballY += directionY;
+	screen.setTile(ballX, ballY, TILE_BALL);
+
+	display.renderTiles(screen);
+
+	delay(100);
+}
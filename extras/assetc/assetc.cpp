@@ -0,0 +1,515 @@
+/*
+ * assetc - converts images and fonts into headers for SH1106Lib
+ *
+ * Reads PBM (P1/P4) images and BDF fonts, and writes a header to the standard output, with the data in the
+ * exact layout the library draws from, and an SH1106Bitmap/SH1106Font struct that describes it. So there is
+ * no conversion work left for the device, and no loose #defines to keep in sync.
+ *
+ * PNG (and the other compressed formats) are not read, to keep it a single file without dependencies, convert
+ * them to PBM first (e.g. convert image.png -monochrome image.pbm).
+ *
+ * Usage: assetc [options] <file.pbm|file.bdf> > asset.h
+ *  --name <name>   the name of the struct (the data array is <name>_data), the default comes from the file name
+ *  --first <code>  fonts: the first character to keep (default: the first one in the font)
+ *  --last <code>   fonts: the last character to keep (default: the last one in the font)
+ *  --shift <rows>  pre-shift the image/characters down by 1..7 rows, so something meant for y = 8 * n + rows
+ *                  can be drawn at y = 8 * n, where every page is written without shifting. The asset gets taller,
+ *                  and the new rows on its top are empty: draw it TRANSPARENT, a SOLID background clears them
+ *
+ * Build: make (or g++ -O2 -o assetc assetc.cpp)
+ * Test: make test (converts the files in test/, and compares them to the headers next to them)
+ *
+ * 2018, noti
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// the same as in SH1106Lib.h
+#define FONT_NUMBERS        1
+#define FONT_UPPERCASECHARS 2
+#define FONT_LOWERCASECHARS 4
+#define FONT_HASSPACE       8
+#define FONT_FULL           255
+
+// a 1 bit image, one byte per pixel
+struct Image
+{
+	int width = 0;
+	int height = 0;
+	std::vector<unsigned char> pixels;
+
+	void resize(int w, int h)
+	{
+		width = w;
+		height = h;
+		pixels.assign(w * h, 0);
+	}
+
+	unsigned char get(int x, int y) const
+	{
+		if (x < 0 || y < 0 || x >= width || y >= height)
+		{
+			return 0;
+		}
+		return pixels[y * width + x];
+	}
+
+	void set(int x, int y)
+	{
+		if (x >= 0 && y >= 0 && x < width && y < height)
+		{
+			pixels[y * width + x] = 1;
+		}
+	}
+};
+
+// a font, with a fixed size cell for every character
+struct Font
+{
+	int width = 0;
+	int height = 0;
+	int first = 256;
+	int last = -1;
+	Image glyphs[256];
+};
+
+static void fail(const char *message, const char *detail = "")
+{
+	fprintf(stderr, "assetc: %s%s\n", message, detail);
+	exit(1);
+}
+
+static bool readFile(const char *path, std::string &contents)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	contents = buffer.str();
+	return true;
+}
+
+// reads the next number of a PBM header, skipping the whitespace and the comments
+static int pbmNumber(const std::string &data, size_t &pos)
+{
+	while (pos < data.size())
+	{
+		if ('#' == data[pos])
+		{
+			while (pos < data.size() && '\n' != data[pos])
+			{
+				pos++;
+			}
+		}
+		else if (isspace((unsigned char)data[pos]))
+		{
+			pos++;
+		}
+		else
+		{
+			break;
+		}
+	}
+	if (pos >= data.size() || !isdigit((unsigned char)data[pos]))
+	{
+		fail("broken PBM header");
+	}
+	int value = 0;
+	while (pos < data.size() && isdigit((unsigned char)data[pos]))
+	{
+		value = value * 10 + (data[pos++] - '0');
+	}
+	return value;
+}
+
+static void loadPbm(const std::string &data, Image &image)
+{
+	size_t pos = 2;
+	bool binary;
+
+	if (data.size() < 2 || 'P' != data[0] || ('1' != data[1] && '4' != data[1]))
+	{
+		fail("only P1 and P4 PBM images are supported");
+	}
+	binary = ('4' == data[1]);
+
+	int w = pbmNumber(data, pos);
+	int h = pbmNumber(data, pos);
+	if (w <= 0 || h <= 0 || w > 255 || h > 255)
+	{
+		fail("the image has to be 1..255 pixels wide and high");
+	}
+	image.resize(w, h);
+
+	if (binary)
+	{ // a single whitespace, then the rows, 8 pixels in a byte, the first one in the most significant bit
+		pos++;
+		int rowBytes = (w + 7) / 8;
+		if (data.size() < pos + (size_t)(rowBytes * h))
+		{
+			fail("the PBM image is truncated");
+		}
+		for (int y = 0; y < h; y++)
+		{
+			for (int x = 0; x < w; x++)
+			{
+				if (data[pos + y * rowBytes + x / 8] & (0x80 >> (x & 7)))
+				{
+					image.set(x, y);
+				}
+			}
+		}
+		return;
+	}
+
+	// ASCII: '0' and '1' characters, the whitespace between them is optional
+	for (int i = 0; i < w * h; i++)
+	{
+		while (pos < data.size() && '0' != data[pos] && '1' != data[pos])
+		{
+			pos++;
+		}
+		if (pos >= data.size())
+		{
+			fail("the PBM image is truncated");
+		}
+		if ('1' == data[pos++])
+		{
+			image.set(i % w, i / w);
+		}
+	}
+}
+
+static void loadBdf(const std::string &data, Font &font)
+{
+	std::istringstream lines(data);
+	std::string line, keyword;
+	int boxX = 0, boxY = 0;
+	int encoding = -1;
+	int glyphWidth = 0, glyphHeight = 0, glyphX = 0, glyphY = 0;
+
+	while (std::getline(lines, line))
+	{
+		std::istringstream words(line);
+		words >> keyword;
+
+		if ("FONTBOUNDINGBOX" == keyword)
+		{
+			words >> font.width >> font.height >> boxX >> boxY;
+			if (font.width <= 0 || font.height <= 0 || font.width > 255 || font.height > 255)
+			{
+				fail("unsupported FONTBOUNDINGBOX");
+			}
+		}
+		else if ("ENCODING" == keyword)
+		{
+			words >> encoding;
+		}
+		else if ("BBX" == keyword)
+		{
+			words >> glyphWidth >> glyphHeight >> glyphX >> glyphY;
+		}
+		else if ("BITMAP" == keyword)
+		{
+			if (0 == font.width)
+			{
+				fail("BITMAP before FONTBOUNDINGBOX");
+			}
+			if (encoding < 0 || encoding > 255)
+			{ // not in the 8 bit range, skip it
+				continue;
+			}
+
+			Image &glyph = font.glyphs[encoding];
+			glyph.resize(font.width, font.height);
+			// the top row of the cell is at boxY + height - 1 above the baseline, the top row of the glyph at glyphY + glyphHeight - 1
+			int top = (boxY + font.height) - (glyphY + glyphHeight);
+			int left = glyphX - boxX;
+			for (int row = 0; row < glyphHeight && std::getline(lines, line); row++)
+			{
+				for (int column = 0; column < glyphWidth; column++)
+				{
+					size_t digit = column / 4;
+					if (digit >= line.size())
+					{
+						break;
+					}
+					int nibble = strtol(line.substr(digit, 1).c_str(), NULL, 16);
+					if (nibble & (8 >> (column & 3)))
+					{
+						glyph.set(left + column, top + row);
+					}
+				}
+			}
+
+			if (encoding < font.first)
+			{
+				font.first = encoding;
+			}
+			if (encoding > font.last)
+			{
+				font.last = encoding;
+			}
+		}
+	}
+
+	if (font.last < 0)
+	{
+		fail("no characters in the 0..255 range in the font");
+	}
+}
+
+// the column of 8 pixels, that starts at row y, the top one in the least significant bit
+static unsigned char column(const Image &image, int x, int y)
+{
+	unsigned char b = 0;
+	for (int k = 0; k < 8; k++)
+	{
+		if (image.get(x, y + k))
+		{
+			b |= 1 << k;
+		}
+	}
+	return b;
+}
+
+static void printBytes(const std::vector<unsigned char> &bytes)
+{
+	for (size_t i = 0; i < bytes.size(); i++)
+	{
+		if (0 == i % 16)
+		{
+			printf("\t");
+		}
+		printf("B");
+		for (int k = 7; k >= 0; k--)
+		{
+			putchar((bytes[i] & (1 << k)) ? '1' : '0');
+		}
+		printf((i == bytes.size() - 1) ? "\n" : ((15 == i % 16) ? ",\n" : ", "));
+	}
+}
+
+static void printHeader(const char *source, int shift)
+{
+	printf("/*\n * Generated by assetc from %s\n * Include it after SH1106Lib.h\n", source);
+	if (0 != shift)
+	{ // the shifted-in rows are empty, a SOLID background would clear whatever is under them
+		printf(" * Shifted down by %d rows: draw it with a TRANSPARENT background, SOLID clears the rows above it\n", shift);
+		fprintf(stderr, "assetc: warning: the top %d rows are empty, draw it with a TRANSPARENT background (SOLID clears them)\n", shift);
+	}
+	printf(" */\n\n");
+}
+
+static void writeBitmap(const char *source, const std::string &name, const Image &image, int shift)
+{
+	int height = image.height + shift;
+	int pages = (height + 7) / 8;
+	std::vector<unsigned char> bytes;
+
+	if (height > 255)
+	{
+		fail("the shifted image is too high");
+	}
+
+	// page by page, and column by column in a page
+	for (int j = 0; j < pages; j++)
+	{
+		for (int i = 0; i < image.width; i++)
+		{
+			bytes.push_back(column(image, i, j * 8 - shift));
+		}
+	}
+
+	printHeader(source, shift);
+	printf("// array size is %u\n", (unsigned)bytes.size());
+	printf("static const byte %s_data[] PROGMEM = {\n", name.c_str());
+	printBytes(bytes);
+	printf("};\n\n");
+	printf("static const SH1106Bitmap %s PROGMEM = { %s_data, %d, %d };\n", name.c_str(), name.c_str(), image.width, height);
+}
+
+static bool covers(int first, int last, int from, int to)
+{
+	return first <= from && last >= to;
+}
+
+static void writeFont(const char *source, const std::string &name, const Font &font, int first, int last, int shift)
+{
+	int height = font.height + shift;
+	int pages = (height + 7) / 8;
+	int flags = 0;
+	std::vector<unsigned char> bytes;
+
+	if (height > 255)
+	{
+		fail("the shifted font is too high");
+	}
+
+	// character by character, column by column in a character, and page by page in a column
+	for (int c = first; c <= last; c++)
+	{
+		for (int i = 0; i < font.width; i++)
+		{
+			for (int j = 0; j < pages; j++)
+			{
+				bytes.push_back(column(font.glyphs[c], i, j * 8 - shift));
+			}
+		}
+	}
+
+	// what the charset contains
+	flags |= covers(first, last, '0', '9') ? FONT_NUMBERS : 0;
+	flags |= covers(first, last, 'A', 'Z') ? FONT_UPPERCASECHARS : 0;
+	flags |= covers(first, last, 'a', 'z') ? FONT_LOWERCASECHARS : 0;
+	flags |= covers(first, last, ' ', ' ') ? FONT_HASSPACE : 0;
+	if ((FONT_NUMBERS | FONT_UPPERCASECHARS | FONT_LOWERCASECHARS | FONT_HASSPACE) == flags)
+	{
+		flags = FONT_FULL;
+	}
+
+	printHeader(source, shift);
+	printf("// characters %d..%d, array size is %u\n", first, last, (unsigned)bytes.size());
+	printf("static const unsigned char %s_data[] PROGMEM = {\n", name.c_str());
+	printBytes(bytes);
+	printf("};\n\n");
+	printf("static const SH1106Font %s PROGMEM = { %s_data, %d, %d, %d, %d, %d };\n", name.c_str(), name.c_str(), font.width, height, first, flags, last);
+}
+
+// file name without the directory and the extension, made into a C identifier
+static std::string nameOf(const std::string &path)
+{
+	size_t slash = path.find_last_of("/\\");
+	std::string name = path.substr((std::string::npos == slash) ? 0 : slash + 1);
+	size_t dot = name.find('.');
+	if (std::string::npos != dot)
+	{
+		name = name.substr(0, dot);
+	}
+	for (size_t i = 0; i < name.size(); i++)
+	{
+		if (!isalnum((unsigned char)name[i]))
+		{
+			name[i] = '_';
+		}
+	}
+	if (name.empty() || isdigit((unsigned char)name[0]))
+	{
+		name = "asset_" + name;
+	}
+	return name;
+}
+
+// a character code, either as a number, or as a single character
+static int charCode(const char *text)
+{
+	if (1 == strlen(text) && !isdigit((unsigned char)text[0]))
+	{
+		return (unsigned char)text[0];
+	}
+	return atoi(text);
+}
+
+static void usage()
+{
+	fprintf(stderr, "usage: assetc [--name <name>] [--first <code>] [--last <code>] [--shift <rows>] <file.pbm|file.bdf>\n");
+	fprintf(stderr, "PNG is not supported, convert it to PBM first (e.g. convert image.png -monochrome image.pbm)\n");
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	const char *path = NULL;
+	std::string name, contents;
+	int first = -1, last = -1, shift = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (0 == strcmp("--name", argv[i]) && i + 1 < argc)
+		{
+			name = argv[++i];
+		}
+		else if (0 == strcmp("--first", argv[i]) && i + 1 < argc)
+		{
+			first = charCode(argv[++i]);
+		}
+		else if (0 == strcmp("--last", argv[i]) && i + 1 < argc)
+		{
+			last = charCode(argv[++i]);
+		}
+		else if (0 == strcmp("--shift", argv[i]) && i + 1 < argc)
+		{
+			shift = atoi(argv[++i]);
+		}
+		else if ('-' == argv[i][0] || NULL != path)
+		{
+			usage();
+		}
+		else
+		{
+			path = argv[i];
+		}
+	}
+
+	if (NULL == path)
+	{
+		usage();
+	}
+	if (shift < 0 || shift > 7)
+	{
+		fail("--shift has to be 0..7");
+	}
+	if (!readFile(path, contents))
+	{
+		fail("can't read ", path);
+	}
+	if (name.empty())
+	{
+		name = nameOf(path);
+	}
+
+	std::string extension = strrchr(path, '.') ? strrchr(path, '.') : "";
+	for (size_t i = 0; i < extension.size(); i++)
+	{
+		extension[i] = tolower((unsigned char)extension[i]);
+	}
+
+	if (".pbm" == extension)
+	{
+		Image image;
+		loadPbm(contents, image);
+		writeBitmap(path, name, image, shift);
+	}
+	else if (".bdf" == extension)
+	{
+		static Font font;
+		loadBdf(contents, font);
+		first = (first < 0) ? font.first : first;
+		last = (last < 0) ? font.last : last;
+		if (first > last || first > 255 || last > 255 || first > 127)
+		{
+			fail("the character range is empty, or does not fit the font offset (the first one has to be 0..127)");
+		}
+		writeFont(path, name, font, first, last, shift);
+	}
+	else if (".png" == extension)
+	{
+		fail("PNG is not supported, convert it to PBM first (e.g. convert image.png -monochrome image.pbm): ", path);
+	}
+	else
+	{
+		fail("unknown file type (PBM and BDF are supported): ", path);
+	}
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+/*
+ * Generated by assetc from test/arrow.pbm
+ * Include it after SH1106Lib.h
+ */
+
+// array size is 10
+static const byte arrow_data[] PROGMEM = {
+	B00000100, B00000010, B11111111, B00000010, B00000100, B00000010, B00000010, B00000011, B00000010, B00000010
+};
+
+static const SH1106Bitmap arrow PROGMEM = { arrow_data, 5, 10 };
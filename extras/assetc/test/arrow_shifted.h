@@ -0,0 +1,12 @@
+/*
+ * Generated by assetc from test/arrow.pbm
+ * Include it after SH1106Lib.h
+ * Shifted down by 3 rows: draw it with a TRANSPARENT background, SOLID clears the rows above it
+ */
+
+// array size is 10
+static const byte arrow_shifted_data[] PROGMEM = {
+	B00100000, B00010000, B11111000, B00010000, B00100000, B00010000, B00010000, B00011111, B00010000, B00010000
+};
+
+static const SH1106Bitmap arrow_shifted PROGMEM = { arrow_shifted_data, 5, 13 };
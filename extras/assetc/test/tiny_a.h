@@ -0,0 +1,11 @@
+/*
+ * Generated by assetc from test/tiny.bdf
+ * Include it after SH1106Lib.h
+ */
+
+// characters 65..65, array size is 4
+static const unsigned char tiny_a_data[] PROGMEM = {
+	B00011110, B00000101, B00011110, B00000000
+};
+
+static const SH1106Font tiny_a PROGMEM = { tiny_a_data, 4, 6, 65, 0, 65 };
@@ -0,0 +1,147 @@
+/*
+ * SH1106Lib\extras\footprint\Footprint.ino
+ * The sketch footprint.sh measures. By default it only uses what a simple text display needs, with
+ * FOOTPRINT_FULL set to 1 it calls every public function, so all of them get linked in.
+ * The configuration comes from the -D flags in budgets.txt, the defaults are the ones the examples use.
+ *
+ * 2018, noti
+ */
+
+// softwareI2C lib
+#ifndef I2C_HARDWARE
+#define I2C_HARDWARE 1
+#endif
+#define I2C_TIMEOUT 10
+#define I2C_MAXWAIT 10
+#define I2C_PULLUP 1
+#define I2C_FASTMODE 1
+#if defined(PORTC)
+#define SDA_PORT PORTC
+#define SDA_PIN 4 // = A4
+#define SCL_PORT PORTC
+#define SCL_PIN 5 // = A5
+#else
+// the ATtinyX5s only have port B, use the USI pins
+#define SDA_PORT PORTB
+#define SDA_PIN 0
+#define SCL_PORT PORTB
+#define SCL_PIN 2
+#endif
+
+// tinyprint lib
+#define TP_PRINTLINES 0
+#define TP_FLASHSTRINGHELPER 1
+#define TP_NUMBERS 0
+#define TP_FLOAT 0
+#define TP_WINDOWSLINEENDS 0
+
+#ifndef FOOTPRINT_FULL
+#define FOOTPRINT_FULL 0
+#endif
+
+#include <SH1106Lib.h>
+
+// a 3 character font, and an 8x8 bitmap, just to have something to draw
+static const unsigned char font[] PROGMEM = {
+	B00011111, B00010001, B00011111, B00000000,
+	B00000000, B00011111, B00000000, B00000000,
+	B00011101, B00010101, B00010111, B00000000
+};
+static const SH1106Font digits PROGMEM = { font, 4, 5, '0', FONT_NUMBERS, '2' };
+static const byte tile[] PROGMEM = { 0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF };
+static const SH1106Bitmap box PROGMEM = { tile, 8, 8 };
+
+SH1106Lib display;
+// the coordinates come from here, so the compiler can't optimize the calls away
+volatile uint8_t input = 0;
+
+#if FOOTPRINT_FULL
+SH1106CommandQueue queue;
+SH1106TileMap tiles(tile);
+SH1106TextField field(display, 0, 56, 4, ALIGN_RIGHT);
+SH1106StripChart chart(display, 64, 0, 64, 32, 0, 255);
+SH1106TextLayout layout;
+byte region[8];
+#endif
+
+void setup() {
+	display.initialize();
+	display.clearDisplay();
+	display.setFont(font, 4, 5, '0', FONT_NUMBERS);
+	display.setTextColor(WHITE, TRANSPARENT);
+	display.setCursor(input, input);
+	display.print(F("012"));
+
+#if FOOTPRINT_FULL
+	display.setRotation(input);
+	display.setViewport(input, input, 64, 32);
+	display.resetViewport();
+	display.setFont(&digits);
+	display.setTextWrap(false);
+	display.fillRect(input, input, 10, 10, WHITE);
+	SH1106Lib::ditherPattern(input, region);
+	display.fillRectPattern(input, input, 10, 10, region);
+	display.drawGrayscaleBitmap(input, input, tile, 4, 2);
+	display.drawBitmap(input, input, tile, 8, 8, INVERSE, SOLID);
+	display.drawBitmap(input, input, &box, WHITE, TRANSPARENT);
+	display.drawBitmapRowMajor(input, input, tile, 8, 8, WHITE, SOLID);
+	display.drawPixel(input, input, WHITE);
+	display.setTextSize(input);
+	display.drawChar(input, input, '1', WHITE, SOLID);
+	display.drawTextBox(input, input, 40, 20, "0 1 2", ALIGN_CENTER, &layout);
+	display.setClipRect(input, input, 10, 10);
+	display.setOrigin(input, input);
+	display.readRegion(input, 0, 8, 1, region);
+	display.writeRegion(input, 0, 8, 1, region);
+	display.printScreenshot(display);
+
+	queue.pushPixel(input, input, WHITE);
+	queue.pushFillRect(input, input, 4, 4, WHITE);
+	queue.pushBitmap(input, input, tile, 8, 8, WHITE, SOLID);
+	queue.pushChar(input, input, '2', WHITE, SOLID);
+	display.drainCommands(queue);
+
+	tiles.setTile(input, input, 0);
+	display.renderTiles(tiles);
+	display.beginPageWrite(input, 0);
+	display.writePageData(input);
+	display.endPageWrite();
+
+	field.setFont(&digits);
+	field.setSize(2);
+	field.update("12");
+
+	chart.setColor(WHITE);
+	chart.clear();
+	chart.push(input);
+
+	display.invert(input);
+	display.allPixelsOn(input);
+	display.setContrast(input);
+	display.sleep();
+	display.wake();
+
+#if SH1106_EFFECTS
+	display.flash(input, 400);
+	display.fadeTo(input, 8, 1000);
+	while (!display.updateEffects())
+	{
+	}
+#endif
+#if SH1106_INCREMENTAL
+	display.queueClearDisplay();
+	display.queueFillRect(input, input, 10, 10, WHITE);
+	display.queueBitmap(input, input, tile, 8, 8, WHITE, SOLID);
+	while (!display.service(1000))
+	{
+	}
+#endif
+#if SH1106_BUSSTATS
+	input = SH1106Lib::modelBusTime(display.getBusStats(), 400000);
+	display.resetBusStats();
+#endif
+#endif
+}
+
+void loop() {
+}
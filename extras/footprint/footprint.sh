@@ -0,0 +1,100 @@
+#!/bin/bash
+#
+# Builds the Footprint sketch in every configuration of budgets.txt, and reports the flash and RAM it uses,
+# with the size of every function of the library. Exits with 1 if a configuration is over its budget.
+# With --update the budgets of the built configurations are set to what they use now, plus the margins, so a
+# change that makes the library bigger fails the next run.
+#
+# Usage: extras/footprint/footprint.sh [--update] [configuration names...]
+# Needs arduino-cli (with the arduino:avr, ATTinyCore and MiniCore cores, SoftI2CMaster and TinyPrint installed),
+# avr-size and avr-nm.
+# Environment:
+#  ARDUINO_CLI          the arduino-cli to use (default: arduino-cli)
+#  AVR_SIZE, AVR_NM     the binutils to use (default: avr-size, avr-nm)
+#  FOOTPRINT_LIBRARIES  a directory with extra libraries (e.g. where TinyPrint is checked out)
+#  FOOTPRINT_BUILD      where to build (default: /tmp/sh1106-footprint)
+#  FLASH_MARGIN, RAM_MARGIN  how much --update leaves above the measured numbers (default: 64 and 8 bytes)
+#
+# 2018, noti
+
+here=$(cd "$(dirname "$0")" && pwd)
+root=$(cd "$here/../.." && pwd)
+arduino=${ARDUINO_CLI:-arduino-cli}
+size=${AVR_SIZE:-avr-size}
+nm=${AVR_NM:-avr-nm}
+build=${FOOTPRINT_BUILD:-/tmp/sh1106-footprint}
+failures=0
+update=0
+flashMargin=${FLASH_MARGIN:-64}
+ramMargin=${RAM_MARGIN:-8}
+
+if [ "$1" = "--update" ]; then
+	update=1
+	shift
+fi
+
+mkdir -p "$build" || exit 1
+budgets="$build/budgets.txt"
+: > "$budgets"
+
+echo "configuration,flash,flash_budget,ram,ram_budget,result"
+
+while IFS= read -r line; do
+	read -r name fqbn flags flashBudget ramBudget <<< "$line"
+	case "$name" in
+		''|'#'*) printf '%s\n' "$line" >> "$budgets"; continue ;;
+	esac
+	if [ $# -gt 0 ] && ! printf '%s\n' "$@" | grep -qx "$name"; then
+		printf '%s\n' "$line" >> "$budgets"
+		continue
+	fi
+
+	defines=""
+	if [ "$flags" != "-" ]; then
+		for flag in ${flags//,/ }; do
+			defines="$defines -D$flag"
+		done
+	fi
+
+	out="$build/$name"
+	if ! "$arduino" compile --fqbn "$fqbn" --library "$root" \
+		${FOOTPRINT_LIBRARIES:+--libraries "$FOOTPRINT_LIBRARIES"} \
+		--build-path "$out" --build-property "compiler.cpp.extra_flags=$defines" \
+		"$here/Footprint" > "$out.log" 2>&1; then
+		echo "$name,,$flashBudget,,$ramBudget,BUILD FAILED (see $out.log)"
+		failures=$((failures + 1))
+		printf '%s\n' "$line" >> "$budgets"
+		continue
+	fi
+
+	elf="$out/Footprint.ino.elf"
+	read -r text data bss <<< "$("$size" -A "$elf" | awk '$1 == ".text" { t = $2 } $1 == ".data" { d = $2 } $1 == ".bss" { b = $2 } END { print t + 0, d + 0, b + 0 }')"
+	flash=$((text + data))
+	ram=$((data + bss))
+
+	if [ "$update" -eq 1 ]; then
+		flashBudget=$((flash + flashMargin))
+		ramBudget=$((ram + ramMargin))
+	fi
+	printf '%-27s %-47s %-112s %-6s %s\n' "$name" "$fqbn" "$flags" "$flashBudget" "$ramBudget" >> "$budgets"
+
+	result=PASS
+	if [ "$flash" -gt "$flashBudget" ] || [ "$ram" -gt "$ramBudget" ]; then
+		result=FAIL
+		failures=$((failures + 1))
+	fi
+	echo "$name,$flash,$flashBudget,$ram,$ramBudget,$result"
+
+	# the size of every symbol of the library (t: code in .text, d: .data, b: .bss), biggest first
+	"$nm" -C -S --size-sort --radix=d "$elf" | awk '/SH1106/ {
+		symbol = $4; for (i = 5; i <= NF; i++) symbol = symbol " " $i;
+		print ($2 + 0) "," $3 ",\"" symbol "\""
+	}' | sort -t, -k1,1nr > "$out.functions.csv"
+	sed 's/^/    /' "$out.functions.csv"
+done < "$here/budgets.txt"
+
+if [ "$update" -eq 1 ]; then
+	cp "$budgets" "$here/budgets.txt"
+fi
+echo "failures,$failures"
+[ "$failures" -eq 0 ]
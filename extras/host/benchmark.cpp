@@ -0,0 +1,67 @@
+/*
+ * Runs the workloads of the Benchmark example (examples/Benchmark/BenchmarkWorkloads.h) on the computer,
+ * against the model of the display controller in mock/, and prints the traffic of every workload as CSV,
+ * with the time it takes on the wire at 100kHz, 400kHz and 1MHz (see modelBusTime()).
+ * It only depends on the code of the lib, so the output (benchmark.csv) is committed, and the diff of it
+ * shows what a change does to the traffic. Build it with BENCHFLAGS (e.g. -DSH1106_COMPOSE_BUFFER=32)
+ * to measure a configuration.
+ *
+ * 2018, noti
+ */
+#include <stdio.h>
+
+#define SH1106_BUSSTATS 1
+
+#include "SH1106Lib.h"
+#include "font_3x5.h"
+
+SH1106Lib display;
+uint8_t failures = 0;
+
+#include "BenchmarkWorkloads.h"
+
+void startWorkload()
+{
+	rngState = 0xACE1;
+	display.resetBusStats();
+	mockDisplay.starts = mockDisplay.stops = mockDisplay.bytesWritten = mockDisplay.bytesRead = 0;
+	mockDisplay.errors = 0;
+}
+
+void reportWorkload(const __FlashStringHelper *name)
+{
+	const SH1106BusStats& stats = display.getBusStats();
+
+	printf("%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", reinterpret_cast<const char *>(name),
+		(unsigned long)stats.starts, (unsigned long)stats.stops,
+		(unsigned long)stats.bytesWritten, (unsigned long)stats.bytesRead,
+		(unsigned long)SH1106Lib::modelBusTime(stats, 100000),
+		(unsigned long)SH1106Lib::modelBusTime(stats, 400000),
+		(unsigned long)SH1106Lib::modelBusTime(stats, 1000000));
+
+	// the counters of the lib have to agree with what the bus has seen
+	if (stats.starts != mockDisplay.starts || stats.stops != mockDisplay.stops
+		|| stats.bytesWritten != mockDisplay.bytesWritten || stats.bytesRead != mockDisplay.bytesRead)
+	{
+		fprintf(stderr, "%s: the bus stats are different from the traffic on the bus\n", reinterpret_cast<const char *>(name));
+		failures++;
+	}
+	if (mockDisplay.errors)
+	{
+		fprintf(stderr, "%s: %lu protocol errors\n", reinterpret_cast<const char *>(name), (unsigned long)mockDisplay.errors);
+		failures++;
+	}
+}
+
+int main()
+{
+	mockDisplay.reset();
+	display.initialize();
+	display.clearDisplay();
+
+	printf("workload,starts,stops,bytes_written,bytes_read,model_us_100k,model_us_400k,model_us_1m\n");
+
+	runWorkloads();
+
+	return failures ? 1 : 0;
+}
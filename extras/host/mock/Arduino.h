@@ -0,0 +1,44 @@
+/*
+ * The part of the Arduino core that the lib, the regression cases and the benchmark workloads use,
+ * for building them on the computer. The program memory is the normal memory here, and the clock
+ * is moved forward by the mock I2C bus (see SoftI2CMaster.h), so the timing is deterministic.
+ *
+ * 2018, noti
+ */
+#ifndef ARDUINO_H_MOCK
+#define ARDUINO_H_MOCK
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "binary.h"
+
+typedef uint8_t byte;
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define memcpy_P memcpy
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// it is here, so a global of the same name (e.g. a tile map called map) does not compile on the computer either
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+	return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+#define DEC 10
+#define HEX 16
+
+// the time in microseconds, it only moves when the mock bus transfers a byte or delay() is called
+extern unsigned long mockMicros;
+
+inline unsigned long micros() { return mockMicros; }
+inline unsigned long millis() { return mockMicros / 1000; }
+inline void delay(unsigned long ms) { mockMicros += ms * 1000; }
+
+#endif
@@ -0,0 +1,242 @@
+/*
+ * A mock of the SoftI2CMaster lib with a model of the SH1106 behind it
+ * The model keeps the 132x64 display memory, the page and column pointers, the read-modify-write mode, the scan directions
+ * and the data/command mode of the last control byte, so a read returns what the real controller would:
+ * the status register after command bytes, a dummy byte first after the data mode was selected, and the
+ * display memory after that. Everything that would confuse the real controller is counted in errors.
+ * Every transferred byte moves the clock (see micros() in Arduino.h) by 23us, that is 9 clocks at 400kHz.
+ *
+ * 2018, noti
+ */
+#ifndef SOFTI2CMASTER_H_MOCK
+#define SOFTI2CMASTER_H_MOCK
+
+#include <Arduino.h>
+
+#define MOCK_COLUMNS 132
+#define MOCK_PAGES 8
+#define MOCK_BYTE_TIME 23
+
+struct MockSH1106
+{
+	byte ram[MOCK_PAGES][MOCK_COLUMNS];
+	uint8_t page;
+	uint8_t column;
+	bool readModifyWrite;
+	uint8_t rmwColumn;
+	// the state of the current transaction
+	bool started;
+	bool reading;
+	bool expectControl;
+	bool continuation;
+	bool dataMode;
+	bool dummyRead;
+	// the second byte of a double byte command is expected
+	byte pendingCommand;
+	// the display state
+	bool displayOn;
+	bool inverted;
+	bool allOn;
+	// the scan directions, the 180 degrees rotation is done with these
+	bool segmentRemap;
+	bool comScanDecrement;
+	byte contrast;
+	uint8_t startLine;
+	// the traffic, the same way SH1106BusStats counts it
+	uint32_t starts;
+	uint32_t stops;
+	uint32_t bytesWritten;
+	uint32_t bytesRead;
+	// the number of protocol errors
+	uint32_t errors;
+
+	void reset()
+	{
+		memset(this, 0, sizeof(*this));
+	}
+
+	void command(byte c)
+	{
+		if (pendingCommand)
+		{
+			if (0x81 == pendingCommand)
+			{
+				contrast = c;
+			}
+			pendingCommand = 0;
+			return;
+		}
+		if (c <= 0x0F)
+		{
+			column = (column & 0xF0) | c;
+		}
+		else if (c <= 0x1F)
+		{
+			column = (column & 0x0F) | ((c & 0x0F) << 4);
+		}
+		else if (c >= 0x40 && c <= 0x7F)
+		{
+			startLine = c - 0x40;
+		}
+		else if (c >= 0xB0 && c <= 0xB7)
+		{
+			page = c - 0xB0;
+		}
+		else if (0xE0 == c)
+		{
+			readModifyWrite = true;
+			rmwColumn = column;
+		}
+		else if (0xEE == c)
+		{
+			readModifyWrite = false;
+			column = rmwColumn;
+		}
+		else if (0xA0 == c || 0xA1 == c)
+		{
+			segmentRemap = (0xA1 == c);
+		}
+		else if (0xC0 == c || 0xC8 == c)
+		{
+			comScanDecrement = (0xC8 == c);
+		}
+		else if (0xA4 == c || 0xA5 == c)
+		{
+			allOn = (0xA5 == c);
+		}
+		else if (0xA6 == c || 0xA7 == c)
+		{
+			inverted = (0xA7 == c);
+		}
+		else if (0xAE == c || 0xAF == c)
+		{
+			displayOn = (0xAF == c);
+		}
+		else if (0x81 == c || 0xA8 == c || 0xAD == c || 0xD3 == c || 0xD5 == c || 0xD9 == c || 0xDA == c || 0xDB == c)
+		{
+			pendingCommand = c;
+		}
+		else if (c >= 0xB8 && c <= 0xBF)
+		{ // there is no such page
+			errors++;
+		}
+	}
+
+	void data(byte d)
+	{
+		if (column >= MOCK_COLUMNS)
+		{
+			errors++;
+			return;
+		}
+		ram[page][column] = d;
+		if (column < MOCK_COLUMNS - 1)
+		{
+			column++;
+		}
+	}
+
+	byte read()
+	{
+		byte value;
+
+		if (!dataMode)
+		{ // the status register: the busy flag and the display off flag
+			return displayOn ? 0x00 : 0x40;
+		}
+		if (dummyRead)
+		{
+			dummyRead = false;
+			return 0x00;
+		}
+		if (column >= MOCK_COLUMNS)
+		{
+			errors++;
+			return 0x00;
+		}
+		value = ram[page][column];
+		// only the writes move the column pointer in read-modify-write mode
+		if (!readModifyWrite && column < MOCK_COLUMNS - 1)
+		{
+			column++;
+		}
+		return value;
+	}
+};
+
+extern MockSH1106 mockDisplay;
+
+inline bool i2c_init()
+{
+	return true;
+}
+
+inline bool i2c_start(uint8_t address)
+{
+	mockDisplay.started = true;
+	mockDisplay.reading = address & 1;
+	mockDisplay.expectControl = true;
+	mockDisplay.dummyRead = true;
+	mockDisplay.starts++;
+	mockDisplay.bytesWritten++;
+	mockMicros += MOCK_BYTE_TIME;
+	return true;
+}
+
+inline bool i2c_rep_start(uint8_t address)
+{
+	return i2c_start(address);
+}
+
+inline void i2c_stop()
+{
+	if (!mockDisplay.started)
+	{
+		mockDisplay.errors++;
+	}
+	mockDisplay.started = false;
+	mockDisplay.stops++;
+}
+
+inline bool i2c_write(uint8_t value)
+{
+	mockDisplay.bytesWritten++;
+	mockMicros += MOCK_BYTE_TIME;
+	if (!mockDisplay.started || mockDisplay.reading)
+	{
+		mockDisplay.errors++;
+		return false;
+	}
+	if (mockDisplay.expectControl)
+	{ // the control byte: Co (more control bytes follow) and D/C (data or command)
+		mockDisplay.continuation = value & 0x80;
+		mockDisplay.dataMode = value & 0x40;
+		mockDisplay.expectControl = false;
+		return true;
+	}
+	if (mockDisplay.dataMode)
+	{
+		mockDisplay.data(value);
+	}
+	else
+	{
+		mockDisplay.command(value);
+	}
+	mockDisplay.expectControl = mockDisplay.continuation;
+	return true;
+}
+
+inline uint8_t i2c_read(bool last)
+{
+	(void)last;
+	mockDisplay.bytesRead++;
+	mockMicros += MOCK_BYTE_TIME;
+	if (!mockDisplay.started || !mockDisplay.reading)
+	{
+		mockDisplay.errors++;
+		return 0xFF;
+	}
+	return mockDisplay.read();
+}
+
+#endif
@@ -0,0 +1,37 @@
+/*
+ * The part of the TinyPrint lib that the lib, the regression cases and the benchmark workloads use
+ *
+ * 2018, noti
+ */
+#ifndef TINYPRINT_H_MOCK
+#define TINYPRINT_H_MOCK
+
+#include <Arduino.h>
+
+class TinyPrint
+{
+public:
+	virtual byte write(uint8_t) = 0;
+
+	size_t print(const char *text)
+	{
+		size_t n = 0;
+		while (*text)
+		{
+			n += write(*text++);
+		}
+		return n;
+	}
+
+	size_t print(const __FlashStringHelper *text)
+	{
+		return print(reinterpret_cast<const char *>(text));
+	}
+
+	size_t print(char c)
+	{
+		return write(c);
+	}
+};
+
+#endif
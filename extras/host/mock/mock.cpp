@@ -0,0 +1,10 @@
+/*
+ * The state of the mocks
+ *
+ * 2018, noti
+ */
+#include <Arduino.h>
+#include <SoftI2CMaster.h>
+
+unsigned long mockMicros = 0;
+MockSH1106 mockDisplay;
@@ -0,0 +1,291 @@
+/*
+ * Runs the cases of the Regression example (examples/Regression/RegressionCases.h) on the computer, against
+ * the model of the display controller in mock/, and compares the whole display memory after every case to
+ * golden/<case>.pbm. The memory is read back with printScreenshot(), so the read path is tested too.
+ * If a case fails, what it drew is written to golden/<case>.actual.pbm, next to the expected image.
+ * The CRCs in examples/Regression/golden.h are checked as well, so the sketch on the board stays in sync.
+ *
+ * Usage: regression [--record]
+ *  --record  writes the image of every case into golden/ and prints a new golden.h, instead of checking them
+ * The cases in runHostCases() only run here, they step the clock of the mock to check the timed effects.
+ *
+ * 2018, noti
+ */
+#include <stdio.h>
+
+#define SH1106_BUSSTATS 1
+#define SH1106_INCREMENTAL 1
+#define SH1106_EFFECTS 1
+
+#include "SH1106Lib.h"
+#include "glcdfont.h"
+#include "font_3x5.h"
+#include "golden.h"
+
+#ifndef GOLDEN_DIR
+#define GOLDEN_DIR "golden"
+#endif
+
+// the size of a 132x64 P4 image with its "P4\n132 64\n" header
+#define SCREENSHOT_SIZE (10 + (SH1106_NUMBEROF_SEGMENTS + 4 + 7) / 8 * SH1106_LCDHEIGHT)
+
+class ScreenshotBuffer : public TinyPrint
+{
+public:
+	byte data[SCREENSHOT_SIZE];
+	size_t length;
+
+	virtual byte write(uint8_t c) override
+	{
+		if (length < sizeof(data))
+		{
+			data[length] = c;
+		}
+		length++;
+		return 1;
+	}
+};
+
+SH1106Lib display;
+ScreenshotBuffer screenshot;
+bool record = false;
+uint8_t failures = 0;
+
+uint16_t crc16(uint16_t crc, byte data)
+{
+	crc ^= (uint16_t)data << 8;
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+	}
+	return crc;
+}
+
+bool writeImage(const char *path, const byte *data, size_t length)
+{
+	FILE *f = fopen(path, "wb");
+	bool ok;
+
+	if (!f)
+	{
+		fprintf(stderr, "can not write %s\n", path);
+		return false;
+	}
+	ok = (fwrite(data, 1, length, f) == length);
+	fclose(f);
+	return ok;
+}
+
+/*
+Returns 1 if the image in path is the same as the screenshot, 0 if it is different, and -1 if there is no such file
+*/
+int compareImage(const char *path)
+{
+	byte expected[SCREENSHOT_SIZE + 1];
+	size_t length;
+	FILE *f = fopen(path, "rb");
+
+	if (!f)
+	{
+		return -1;
+	}
+	length = fread(expected, 1, sizeof(expected), f);
+	fclose(f);
+	return (length == screenshot.length && 0 == memcmp(expected, screenshot.data, length)) ? 1 : 0;
+}
+
+/*
+The CRC of the visible part of the display memory, read back page by page
+*/
+uint16_t displayCrc()
+{
+	byte page[SH1106_LCDWIDTH];
+	uint16_t crc = 0xFFFF;
+
+	for (uint8_t j = 0; j < SH1106_NUMBEROF_PAGES; j++)
+	{
+		display.readRegion(0, j, SH1106_LCDWIDTH, 1, page);
+		for (uint8_t i = 0; i < SH1106_LCDWIDTH; i++)
+		{
+			crc = crc16(crc, page[i]);
+		}
+	}
+	return crc;
+}
+
+void beginCase()
+{
+	display.setRotation(0);
+	display.clearDisplay();
+	display.resetBusStats();
+	mockDisplay.errors = 0;
+}
+
+void endCase(const __FlashStringHelper *name, uint16_t golden)
+{
+	const char *caseName = reinterpret_cast<const char *>(name);
+	const SH1106BusStats& stats = display.getBusStats();
+	uint32_t busBytes = stats.bytesWritten + stats.bytesRead;
+	// the same CRC as the sketch calculates
+	uint16_t crc = displayCrc();
+	char expectedPath[128];
+	char actualPath[128];
+	int image;
+	bool passed;
+
+	screenshot.length = 0;
+	display.printScreenshot(screenshot);
+	// the 180 and 270 degrees rotations flip the scan directions, the others have to restore them
+	if (mockDisplay.segmentRemap == (0 != (display.getRotation() & 2))
+		|| mockDisplay.comScanDecrement == (0 != (display.getRotation() & 2)))
+	{
+		mockDisplay.errors++;
+	}
+
+	snprintf(expectedPath, sizeof(expectedPath), "%s/%s.pbm", GOLDEN_DIR, caseName);
+	snprintf(actualPath, sizeof(actualPath), "%s/%s.actual.pbm", GOLDEN_DIR, caseName);
+
+	if (record)
+	{
+		if (!writeImage(expectedPath, screenshot.data, screenshot.length))
+		{
+			failures++;
+		}
+		printf("#define GOLDEN_%s 0x%X\n", caseName, crc);
+		return;
+	}
+
+	image = compareImage(expectedPath);
+	passed = (1 == image && crc == golden && 0 == mockDisplay.errors);
+	if (1 == image)
+	{
+		remove(actualPath);
+	}
+	else
+	{
+		writeImage(actualPath, screenshot.data, screenshot.length);
+	}
+	printf("%s,%X,%X,%lu,%s,%lu,%s\n", caseName, crc, golden, (unsigned long)busBytes,
+		(1 == image) ? "same" : ((0 == image) ? "different" : "missing"), (unsigned long)mockDisplay.errors,
+		passed ? "PASS" : "FAIL");
+	if (!passed)
+	{
+		failures++;
+	}
+}
+
+/*
+Checks something about a case that the image does not show, e.g. the traffic on the bus
+*/
+void expect(const __FlashStringHelper *name, bool passed)
+{
+	if (record)
+	{ // stdout is the new golden.h, and a check can depend on the golden values that are being recorded
+		if (!passed)
+		{
+			fprintf(stderr, "%s: FAIL\n", reinterpret_cast<const char *>(name));
+		}
+		return;
+	}
+	if (!passed)
+	{
+		failures++;
+	}
+	printf("%s,,,,,,%s\n", reinterpret_cast<const char *>(name), passed ? "PASS" : "FAIL");
+}
+
+#include "RegressionCases.h"
+
+/*
+The cases that need the mock: the effects only change the controller state (the contrast and the inversion), not
+the display memory, and they are driven by the clock, which is stepped by hand here
+*/
+void runHostCases()
+{
+	unsigned long start;
+	unsigned long elapsed;
+	uint8_t changes;
+	uint8_t lastContrast;
+	bool lastInverted;
+	bool timing;
+	bool done;
+
+	// fadeTo with the default duration of 500ms, 4 steps: one contrast command every 125ms
+	display.setContrast(100);
+	display.fadeTo(200, 4);
+	start = millis();
+	changes = 0;
+	timing = true;
+	lastContrast = mockDisplay.contrast;
+	do
+	{
+		delay(5);
+		done = display.updateEffects();
+		if (mockDisplay.contrast != lastContrast)
+		{
+			changes++;
+			elapsed = millis() - start;
+			// 100, 125, 150, 175, 200, each step right when it is due
+			timing &= (mockDisplay.contrast == 100 + changes * 25) && elapsed >= changes * 125UL && elapsed < changes * 125UL + 10;
+			lastContrast = mockDisplay.contrast;
+		}
+	} while (!done && millis() - start < 2000);
+	expect(F("FADE_STEPS"), 4 == changes && timing);
+	expect(F("FADE_TARGET"), done && 200 == mockDisplay.contrast && millis() - start < 510);
+
+	// a fade with its own duration, that is late: it catches up with a single command
+	display.fadeTo(50, 10, 100);
+	delay(300);
+	lastContrast = mockDisplay.contrast;
+	expect(F("FADE_LATE"), display.updateEffects() && 50 == mockDisplay.contrast && 200 == lastContrast);
+
+	// flash(3, 100) toggles the inversion 6 times, every 50ms, then the state set by invert() is back
+	display.invert(true);
+	display.flash(3, 100);
+	start = millis();
+	changes = mockDisplay.inverted ? 0 : 1;
+	lastInverted = mockDisplay.inverted;
+	do
+	{
+		delay(5);
+		done = display.updateEffects();
+		if (mockDisplay.inverted != lastInverted)
+		{
+			changes++;
+			lastInverted = mockDisplay.inverted;
+		}
+	} while (!done && millis() - start < 2000);
+	elapsed = millis() - start;
+	expect(F("FLASH_TOGGLES"), 6 == changes && elapsed >= 250 && elapsed < 260);
+	expect(F("FLASH_RESTORES_INVERT"), done && mockDisplay.inverted);
+	display.invert(false);
+	expect(F("FLASH_NORMAL"), !mockDisplay.inverted);
+}
+
+int main(int argc, char **argv)
+{
+	record = (argc > 1 && 0 == strcmp(argv[1], "--record"));
+
+	mockDisplay.reset();
+	display.initialize();
+	display.setTextWrap(true);
+
+	if (record)
+	{
+		printf("/*\n * Golden CRC values for the Regression example\n");
+		printf(" * Recorded with REGRESSION_RECORD set to 1, or with make record in extras/host\n */\n");
+	}
+	else
+	{
+		printf("case,crc,golden,bus_bytes,image,bus_errors,result\n");
+	}
+
+	runCases();
+	runHostCases();
+
+	if (!record)
+	{
+		printf("failures,%u\n", failures);
+	}
+	return failures ? 1 : 0;
+}